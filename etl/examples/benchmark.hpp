@@ -0,0 +1,106 @@
+/// @brief A tiny timing harness shared by the example benchmarks.
+///
+/// @details Deliberately dependency free, it only needs to be good enough to compare
+/// two implementations of the same operation side by side.
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace bench
+{
+
+/// @brief Keeps the optimizer from discarding a value that is computed but never used.
+template <typename T> inline auto doNotOptimize(T const &value) -> void
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile auto sink = value;
+    sink = value;
+#endif
+}
+
+/// @brief Runs `func` `iterations` times and prints the time per operation and the throughput.
+///
+/// @return The average number of nanoseconds per operation.
+template <typename Function> auto run(std::string_view name, std::size_t iterations, Function &&func) -> double
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+        func();
+    }
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    const auto nanos_per_op = elapsed / static_cast<double>(iterations);
+    std::cout << std::left << std::setw(48) << name << std::right << std::setw(12) << std::fixed
+              << std::setprecision(1) << nanos_per_op << " ns/op" << std::setw(16) << std::setprecision(0)
+              << (1e9 / nanos_per_op) << " ops/s\n";
+    return nanos_per_op;
+}
+
+/// @brief Times every single call of `func` and prints the median, tail and worst latencies.
+///
+/// @details For operations on a request path, where the slowest calls matter more than the average.
+template <typename Function> auto latency(std::string_view name, std::size_t iterations, Function &&func) -> void
+{
+    std::vector<double> samples(iterations);
+    for (auto &sample : samples)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        func();
+        sample = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+    std::sort(samples.begin(), samples.end());
+
+    const auto percentile = [&samples](double fraction) {
+        return samples[static_cast<std::size_t>(fraction * static_cast<double>(samples.size() - 1))];
+    };
+    std::cout << std::left << std::setw(40) << name << std::right << std::fixed << std::setprecision(0)
+              << " p50 " << std::setw(8) << percentile(0.5) << " ns  p99 " << std::setw(8) << percentile(0.99)
+              << " ns  p99.9 " << std::setw(9) << percentile(0.999) << " ns  max " << std::setw(10)
+              << samples.back() << " ns\n";
+}
+
+/// @brief Runs `func(thread)` `iterations` times on each of `threads` threads at once, and prints the time
+/// per operation and the combined throughput of all threads.
+///
+/// @return The average number of nanoseconds per operation, as seen by one thread.
+template <typename Function>
+auto runParallel(std::string_view name, std::size_t threads, std::size_t iterations, Function &&func) -> double
+{
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t thread = 0; thread < threads; ++thread)
+    {
+        workers.emplace_back([&func, thread, iterations] {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                func(thread);
+            }
+        });
+    }
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    const auto nanos_per_op = elapsed / static_cast<double>(iterations);
+    const auto total_ops = static_cast<double>(iterations) * static_cast<double>(threads);
+    std::cout << std::left << std::setw(48) << name << std::right << std::setw(12) << std::fixed
+              << std::setprecision(1) << nanos_per_op << " ns/op" << std::setw(16) << std::setprecision(0)
+              << (total_ops * 1e9 / elapsed) << " ops/s\n";
+    return nanos_per_op;
+}
+
+} // namespace bench
@@ -0,0 +1,214 @@
+/// @brief Compares the heap allocated Deck/Card/Player against the
+/// compact, value semantic versions.
+#include "../benchmark.hpp"
+#include "blackjack.hpp"
+#include "hand_batch.hpp"
+#include "shoe.hpp"
+#include "strategy.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+constexpr std::size_t iterations = 100'000;
+
+/// @brief Decks are built with a fixed seed so the benchmarks measure building
+/// the deck, not reading entropy for its generator.
+constexpr std::uint64_t seed = 42;
+
+/// @brief Hands evaluated per call by the batch benchmarks, roughly what the simulator plays in a block.
+constexpr std::size_t batch_hands = 4096;
+
+template <typename DeckType> auto drawAll(DeckType &deck) -> std::size_t
+{
+    std::size_t drawn = 0;
+    while (deck.size() > 0)
+    {
+        if (auto result = deck.drawCard(); result.is_ok())
+        {
+            ++drawn;
+        }
+    }
+    return drawn;
+}
+
+/// @brief The empty deck path with a general purpose Error, carrying its message and source location.
+auto drawWithError(blackjack::CompactDeck &deck) -> Result<blackjack::CompactCard, Error>
+{
+    if (deck.size() == 0)
+    {
+        return Result<blackjack::CompactCard, Error>(Error::create("Deck is empty", RUNTIME_INFO));
+    }
+    return Result<blackjack::CompactCard, Error>(deck.drawCard().ok().value());
+}
+
+auto drawWithStaticError(blackjack::CompactDeck &deck) -> Result<blackjack::CompactCard, StaticError>
+{
+    return deck.drawCard();
+}
+
+/// @brief Draws until the deck reports that it is empty, so every call takes the error path once.
+template <typename Draw> auto drawUntilEmpty(blackjack::CompactDeck &deck, Draw &&draw) -> std::size_t
+{
+    std::size_t drawn = 0;
+    for (auto result = draw(deck); result.is_ok(); result = draw(deck))
+    {
+        ++drawn;
+    }
+    return drawn;
+}
+
+} // namespace
+
+auto main() -> int
+{
+    using namespace blackjack;
+
+    std::cout << "-- build\n";
+    bench::run("Deck (unique_ptr<Card>)", iterations, [] {
+        Deck deck(seed);
+        bench::doNotOptimize(deck);
+    });
+    bench::run("CompactDeck (std::array<CompactCard, 52>)", iterations, [] {
+        CompactDeck deck(seed);
+        bench::doNotOptimize(deck);
+    });
+
+    std::cout << "-- shuffle\n";
+    Deck deck;
+    CompactDeck compactDeck;
+    bench::run("random_device + mt19937 per shuffle", iterations, [&compactDeck] {
+        std::random_device random_number;
+        std::mt19937 generator(random_number());
+        compactDeck.shuffleDeck(generator);
+    });
+    std::mt19937 mersenne(std::random_device{}());
+    bench::run("reused mt19937", iterations, [&compactDeck, &mersenne] { compactDeck.shuffleDeck(mersenne); });
+    bench::run("Deck::shuffleDeck (xoshiro256**)", iterations, [&deck] { deck.shuffleDeck(); });
+    bench::run("CompactDeck::shuffleDeck (xoshiro256**)", iterations, [&compactDeck] { compactDeck.shuffleDeck(); });
+
+    std::cout << "-- build and draw 52 cards\n";
+    bench::run("Deck::drawCard", iterations, [] {
+        Deck fresh(seed);
+        bench::doNotOptimize(drawAll(fresh));
+    });
+    bench::run("CompactDeck::drawCard", iterations, [&compactDeck] {
+        compactDeck.reset();
+        bench::doNotOptimize(drawAll(compactDeck));
+    });
+
+    std::cout << "-- draw until empty\n";
+    bench::run("Result<CompactCard, Error> + RUNTIME_INFO", iterations, [&compactDeck] {
+        compactDeck.reset();
+        bench::doNotOptimize(drawUntilEmpty(compactDeck, drawWithError));
+    });
+    bench::run("Result<CompactCard, StaticError>", iterations, [&compactDeck] {
+        compactDeck.reset();
+        bench::doNotOptimize(drawUntilEmpty(compactDeck, drawWithStaticError));
+    });
+
+    std::cout << "-- empty deck error\n";
+    CompactDeck emptyDeck(seed);
+    drawAll(emptyDeck);
+    bench::run("Error::create(msg, RUNTIME_INFO)", iterations * 10,
+               [&emptyDeck] { bench::doNotOptimize(drawWithError(emptyDeck)); });
+    bench::run("errors::deck_empty (StaticError)", iterations * 10,
+               [&emptyDeck] { bench::doNotOptimize(emptyDeck.drawCard()); });
+
+    std::cout << "-- hand value (3 cards)\n";
+    Deck handDeck;
+    CompactDeck compactHandDeck;
+    Player player;
+    CompactPlayer compactPlayer;
+    for (int i = 0; i < 3; ++i)
+    {
+        player.addCard(std::move(handDeck.drawCard().ok().value()));
+        compactPlayer.addCard(compactHandDeck.drawCard().ok().value());
+    }
+    bench::run("Player::getHandValue", iterations * 10, [&player] { bench::doNotOptimize(player.getHandValue()); });
+    bench::run("CompactPlayer::getHandValue", iterations * 10,
+               [&compactPlayer] { bench::doNotOptimize(compactPlayer.getHandValue()); });
+
+    std::cout << "-- basic strategy\n";
+    std::uint32_t decision = 0;
+    bench::run("basicStrategy lookup", iterations * 10, [&decision] {
+        const auto total = static_cast<std::uint16_t>(4 + (decision % 18));
+        const auto upcard = static_cast<std::uint8_t>(2 + (decision % 10));
+        bench::doNotOptimize(basicStrategy(total, (decision & 1U) != 0, upcard, (decision & 2U) != 0));
+        ++decision;
+    });
+
+    std::cout << "-- hand value (" << batch_hands << " hands of 3 cards)\n";
+    Shoe<6> shoe(seed);
+    std::vector<Player> players(batch_hands);
+    std::vector<CompactPlayer> compactPlayers(batch_hands);
+    HandBatch batch(batch_hands);
+    for (int i = 0; i < 3; ++i)
+    {
+        for (std::size_t hand = 0; hand < batch_hands; ++hand)
+        {
+            if (shoe.needsShuffle())
+            {
+                shoe.shuffle();
+            }
+            const auto card = shoe.drawCard().ok().value();
+            players[hand].addCard(std::make_unique<Card>(card.getRank(), card.getSuite()));
+            compactPlayers[hand].addCard(card);
+            batch.addCard(hand, card);
+        }
+    }
+
+    std::vector<std::uint16_t> values(batch_hands);
+    bench::run("Player::getHandValue", iterations / 10, [&players, &values] {
+        for (std::size_t hand = 0; hand < batch_hands; ++hand)
+        {
+            values[hand] = players[hand].getHandValue();
+        }
+        bench::doNotOptimize(values.data());
+    });
+    bench::run("CompactPlayer::getHandValue", iterations / 10, [&compactPlayers, &values] {
+        for (std::size_t hand = 0; hand < batch_hands; ++hand)
+        {
+            values[hand] = compactPlayers[hand].getHandValue();
+        }
+        bench::doNotOptimize(values.data());
+    });
+    bench::run("HandBatch::getHandValuesScalar", iterations / 10, [&batch, &values] {
+        batch.getHandValuesScalar(values);
+        bench::doNotOptimize(values.data());
+    });
+    if (HandBatch::hasAvx2())
+    {
+        bench::run("HandBatch::getHandValuesAvx2", iterations / 10, [&batch, &values] {
+            batch.getHandValuesAvx2(values);
+            bench::doNotOptimize(values.data());
+        });
+    }
+    else
+    {
+        std::cout << "HandBatch::getHandValuesAvx2                   skipped, no AVX2\n";
+    }
+
+    // Every kernel has to agree with the per player evaluation.
+    std::vector<std::uint16_t> scalarValues;
+    batch.getHandValues(values);
+    batch.getHandValuesScalar(scalarValues);
+    for (std::size_t hand = 0; hand < batch_hands; ++hand)
+    {
+        const auto expected = players[hand].getHandValue();
+        if (values[hand] != expected || scalarValues[hand] != expected)
+        {
+            std::cerr << "HandBatch disagrees with Player for hand " << hand << '\n';
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,191 @@
+#include "blackjack.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <etl.hpp>
+#include <memory>
+#include <utility>
+
+namespace blackjack
+{
+
+Card::Card(Rank rank, Suit suit) noexcept : _rank(rank), _suit(suit)
+{
+}
+
+auto Card::getRank() const noexcept -> Rank
+{
+    return _rank;
+}
+
+auto Card::getSuite() const noexcept -> Suit
+{
+    return _suit;
+}
+
+Deck::Deck() noexcept
+{
+    buildDeck();
+}
+
+Deck::Deck(std::uint64_t seed) noexcept : _generator(seed)
+{
+    buildDeck();
+}
+
+auto Deck::buildDeck() noexcept -> void
+{
+    for (auto const &suit : SuitIterator())
+    {
+        for (auto const &rank : RankIterator())
+        {
+            _cards.emplace_back(std::make_unique<Card>(rank, suit));
+        }
+    }
+}
+
+auto Deck::size() -> std::size_t
+{
+    return _cards.size();
+}
+
+auto Deck::shuffleDeck() -> void
+{
+    shuffleDeck(_generator);
+}
+
+auto Deck::drawCard() -> Result<UniqueCard, StaticError>
+{
+    if (_cards.empty())
+    {
+        return Result<UniqueCard, StaticError>(errors::deck_empty);
+    }
+    auto card = std::move(_cards.back());
+    _cards.pop_back();
+    return Result<UniqueCard, StaticError>(std::move(card));
+}
+
+auto Player::addCard(Deck::UniqueCard &&card) noexcept -> void
+{
+    _state.add(card->getRank());
+    _hand.emplace_back(std::move(card));
+}
+
+auto Player::getHandValue() -> uint16_t
+{
+    return _state.value();
+}
+
+auto Player::isSoft() const noexcept -> bool
+{
+    return _state.isSoft();
+}
+
+CompactCard::CompactCard(Rank rank, Suit suit) noexcept
+    : _bits(static_cast<std::uint8_t>(static_cast<std::uint8_t>(rank) |
+                                      static_cast<std::uint8_t>(static_cast<std::uint8_t>(suit) << suit_shift)))
+{
+}
+
+auto CompactCard::getRank() const noexcept -> Rank
+{
+    return static_cast<Rank>(_bits & rank_mask);
+}
+
+auto CompactCard::getSuite() const noexcept -> Suit
+{
+    return static_cast<Suit>(_bits >> suit_shift);
+}
+
+auto CompactCard::getValue() const noexcept -> std::uint8_t
+{
+    // Indexed by rank, slot zero is unused since the ranks start at ACE = 1.
+    constexpr std::array<std::uint8_t, 14> values{0, 11, 2, 3, 4, 5, 6, 7, 8, 9, 10, 10, 10, 10};
+    return values[_bits & rank_mask];
+}
+
+CompactDeck::CompactDeck() noexcept
+{
+    buildDeck();
+}
+
+CompactDeck::CompactDeck(std::uint64_t seed) noexcept : _generator(seed)
+{
+    buildDeck();
+}
+
+auto CompactDeck::buildDeck() noexcept -> void
+{
+    std::size_t index = 0;
+    for (auto const &suit : SuitIterator())
+    {
+        for (auto const &rank : RankIterator())
+        {
+            _cards[index++] = CompactCard(rank, suit);
+        }
+    }
+    _remaining = card_count;
+}
+
+auto CompactDeck::size() const noexcept -> std::size_t
+{
+    return _remaining;
+}
+
+auto CompactDeck::reset() noexcept -> void
+{
+    _remaining = card_count;
+}
+
+auto CompactDeck::shuffleDeck() -> void
+{
+    shuffleDeck(_generator);
+}
+
+auto CompactDeck::drawCard() -> Result<CompactCard, StaticError>
+{
+    if (_remaining == 0)
+    {
+        return Result<CompactCard, StaticError>(errors::deck_empty);
+    }
+    return Result<CompactCard, StaticError>(_cards[--_remaining]);
+}
+
+auto CompactPlayer::addCard(CompactCard card) noexcept -> void
+{
+    if (_size < max_hand_size)
+    {
+        _hand[_size++] = card;
+        _state.add(card.getRank());
+    }
+}
+
+auto CompactPlayer::clear() noexcept -> void
+{
+    _size = 0;
+    _state.clear();
+}
+
+auto CompactPlayer::getFirstCard() const noexcept -> CompactCard
+{
+    return _hand[0];
+}
+
+auto CompactPlayer::size() const noexcept -> std::size_t
+{
+    return _size;
+}
+
+auto CompactPlayer::getHandValue() const noexcept -> uint16_t
+{
+    return _state.value();
+}
+
+auto CompactPlayer::isSoft() const noexcept -> bool
+{
+    return _state.isSoft();
+}
+
+} // namespace blackjack
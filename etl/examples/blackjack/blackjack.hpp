@@ -11,6 +11,11 @@
 /// I would share my solution with him and the world (if anyone ever sees this).
 #pragma once
 
+#include "random.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <ctime>
 #include <etl.hpp>
@@ -21,6 +26,14 @@ using namespace etl;
 
 namespace blackjack
 {
+
+/// @brief Running out of cards is routine, it is what triggers a reshuffle, so these errors never allocate.
+namespace errors
+{
+inline const auto deck_empty = StaticError::create("Deck is empty", 1);
+inline const auto shoe_empty = StaticError::create("Shoe is empty", 2);
+} // namespace errors
+
 enum class Rank : std::uint16_t
 {
     ACE = 1,
@@ -72,36 +85,209 @@ class Deck
 
   private:
     std::vector<UniqueCard> _cards;
+    Xoshiro256 _generator;
+
+  private:
+    auto buildDeck() noexcept -> void;
 
   public:
     /// @brief Builds a 52 card deck of 13 ranks with 4 suits,
     ///
     /// @details Uses the custom EnumerationIterator template class to showcase
-    /// the C++ ability to iterate over enums.
+    /// the C++ ability to iterate over enums. The shuffle generator is seeded once
+    /// from std::random_device.
     Deck() noexcept;
 
+    /// @brief Builds the deck with a deterministically seeded shuffle generator.
+    explicit Deck(std::uint64_t seed) noexcept;
+
     /// @brief How many cards are in the deck
     [[nodiscard]] auto size() -> std::size_t;
 
-    /// @brief Uses a random number and The classic Mersenne Twister,
-    /// random number generator to shuffle the deck.
+    /// @brief Shuffles the deck with the generator owned by the deck.
     auto shuffleDeck() -> void;
 
+    /// @brief Shuffles the deck with a caller supplied generator.
+    template <typename UniformRandomBitGenerator> auto shuffleDeck(UniformRandomBitGenerator &generator) -> void
+    {
+        std::shuffle(_cards.begin(), _cards.end(), generator);
+    }
+
     /// @brief Draws a single card from the deck if it isn't emptpy.
     ///
-    /// @returns Result<UniqueCard, Error>
-    [[nodiscard]] auto drawCard() -> Result<UniqueCard, Error>;
+    /// @returns Result<UniqueCard, StaticError>
+    [[nodiscard]] auto drawCard() -> Result<UniqueCard, StaticError>;
+};
+
+/// @brief The value of a card when aces count as one, a single table load.
+[[nodiscard]] constexpr auto hardValue(Rank rank) noexcept -> uint16_t
+{
+    // Indexed by rank, slot zero is unused since the ranks start at ACE = 1.
+    constexpr std::array<uint16_t, 14> hard_values{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 10, 10, 10};
+    return hard_values[static_cast<std::size_t>(rank)];
+}
+
+/// @brief Incrementally maintained value of a blackjack hand.
+///
+/// @details Keeps the hard total, with every ace counted as one, and how many aces are in the hand.
+/// At most one ace can ever count as eleven, so the best value is the hard total plus ten when the
+/// hand holds an ace and that would not bust it. Adding a card is a table load and two adds, and
+/// reading the value is branch free, no matter how many cards are in the hand.
+class HandState
+{
+  public:
+    /// @brief An ace counted as eleven adds ten to the hard total, and only fits while that is eleven or less.
+    static constexpr uint16_t soft_ace_bonus = 10;
+    static constexpr uint16_t max_soft_hard_total = 11;
+
+  private:
+    uint16_t _hardTotal{0};
+    uint16_t _aces{0};
+
+  public:
+    /// @brief Adds the card of the given rank to the running totals.
+    auto add(Rank rank) noexcept -> void
+    {
+        _hardTotal = static_cast<uint16_t>(_hardTotal + hardValue(rank));
+        _aces = static_cast<uint16_t>(_aces + static_cast<uint16_t>(rank == Rank::ACE));
+    }
+
+    auto clear() noexcept -> void
+    {
+        _hardTotal = 0;
+        _aces = 0;
+    }
+
+    /// @brief True when an ace is being counted as eleven.
+    [[nodiscard]] auto isSoft() const noexcept -> bool
+    {
+        return _aces > 0 && _hardTotal <= max_soft_hard_total;
+    }
+
+    /// @brief The best value of the hand, counting one ace as eleven whenever that does not bust it.
+    [[nodiscard]] auto value() const noexcept -> uint16_t
+    {
+        return static_cast<uint16_t>(_hardTotal + (soft_ace_bonus * static_cast<uint16_t>(isSoft())));
+    }
 };
 
 class Player
 {
   private:
     std::vector<Deck::UniqueCard> _hand;
+    HandState _state;
 
   public:
-    auto addCard(Deck::UniqueCard &&card) noexcept;
+    auto addCard(Deck::UniqueCard &&card) noexcept -> void;
 
     [[nodiscard]] auto getHandValue() -> uint16_t;
+
+    /// @brief True when an ace in the hand is being counted as eleven.
+    [[nodiscard]] auto isSoft() const noexcept -> bool;
+};
+
+/// @brief A value semantic card packed into a single byte.
+///
+/// @details The rank lives in the low four bits and the suit in the two bits above it,
+/// so a whole deck fits in 52 bytes and copying a card is copying a byte.
+class CompactCard
+{
+  private:
+    static constexpr std::uint8_t rank_mask = 0x0F;
+    static constexpr std::uint8_t suit_shift = 4;
+
+    std::uint8_t _bits{0};
+
+  public:
+    CompactCard() noexcept = default;
+    CompactCard(Rank rank, Suit suit) noexcept;
+
+    [[nodiscard]] auto getRank() const noexcept -> Rank;
+
+    [[nodiscard]] auto getSuite() const noexcept -> Suit;
+
+    /// @brief The blackjack value of the card, aces count as 11.
+    [[nodiscard]] auto getValue() const noexcept -> std::uint8_t;
+};
+
+class CompactDeck
+{
+  public:
+    static constexpr std::size_t card_count = 52;
+
+  private:
+    using RankIterator = EnumerationIterator<Rank, Rank::ACE, Rank::KING>;
+    using SuitIterator = EnumerationIterator<Suit, Suit::HEARTS, Suit::SPADES>;
+
+  private:
+    /// @brief Cards are drawn from the back, everything at or above `_remaining` has been dealt
+    /// but stays in the array, so resetting the deck never has to rebuild it.
+    std::array<CompactCard, card_count> _cards{};
+    std::size_t _remaining{card_count};
+    Xoshiro256 _generator;
+
+  private:
+    auto buildDeck() noexcept -> void;
+
+  public:
+    /// @brief Builds a 52 card deck of 13 ranks with 4 suits, in place with no heap allocations.
+    /// The shuffle generator is seeded once from std::random_device.
+    CompactDeck() noexcept;
+
+    /// @brief Builds the deck with a deterministically seeded shuffle generator.
+    explicit CompactDeck(std::uint64_t seed) noexcept;
+
+    /// @brief How many cards are left in the deck
+    [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+    /// @brief Puts every dealt card back into the deck, without shuffling.
+    auto reset() noexcept -> void;
+
+    /// @brief Shuffles the cards left in the deck with the generator owned by the deck.
+    auto shuffleDeck() -> void;
+
+    /// @brief Shuffles the cards left in the deck with a caller supplied generator,
+    /// so a seeded generator gives a reproducible order.
+    template <typename UniformRandomBitGenerator> auto shuffleDeck(UniformRandomBitGenerator &generator) -> void
+    {
+        std::shuffle(_cards.begin(), _cards.begin() + static_cast<std::ptrdiff_t>(_remaining), generator);
+    }
+
+    /// @brief Draws a single card from the deck if it isn't emptpy.
+    ///
+    /// @returns Result<CompactCard, StaticError>
+    [[nodiscard]] auto drawCard() -> Result<CompactCard, StaticError>;
+};
+
+class CompactPlayer
+{
+  public:
+    /// @brief Every card adds at least one to the hard total, so no hand can take
+    /// more than 22 cards before it stands on or busts past 21.
+    static constexpr std::size_t max_hand_size = 22;
+
+  private:
+    std::array<CompactCard, max_hand_size> _hand{};
+    std::size_t _size{0};
+    HandState _state;
+
+  public:
+    /// @brief Adds a card to the hand, cards beyond max_hand_size are ignored.
+    auto addCard(CompactCard card) noexcept -> void;
+
+    /// @brief Empties the hand so the player can be reused for the next round.
+    auto clear() noexcept -> void;
+
+    /// @brief The first card dealt, for a dealer this is the up card.
+    [[nodiscard]] auto getFirstCard() const noexcept -> CompactCard;
+
+    /// @brief How many cards are in the hand
+    [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+    [[nodiscard]] auto getHandValue() const noexcept -> uint16_t;
+
+    /// @brief True when an ace in the hand is being counted as eleven.
+    [[nodiscard]] auto isSoft() const noexcept -> bool;
 };
 
 } // namespace blackjack
@@ -0,0 +1,135 @@
+#include "hand_batch.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define BLACKJACK_AVX2_KERNEL 1
+#include <immintrin.h>
+#else
+#define BLACKJACK_AVX2_KERNEL 0
+#endif
+
+namespace blackjack
+{
+
+namespace
+{
+
+/// @brief Evaluates the hands in [first, last), the same formula as HandState::value for every lane.
+auto evaluateScalar(uint16_t const *hardTotals, uint16_t const *aces, uint16_t *values, std::size_t first,
+                    std::size_t last) noexcept -> void
+{
+    for (auto i = first; i < last; ++i)
+    {
+        const auto hard = hardTotals[i];
+        const auto soft = static_cast<uint16_t>(aces[i] > 0) &
+                          static_cast<uint16_t>(hard <= HandState::max_soft_hard_total);
+        values[i] = static_cast<uint16_t>(hard + (HandState::soft_ace_bonus * soft));
+    }
+}
+
+#if BLACKJACK_AVX2_KERNEL
+/// @brief Sixteen 16 bit hands per 256 bit register.
+constexpr std::size_t avx2_lanes = 16;
+
+/// @brief Compiled for AVX2 regardless of the global flags, only ever called after checking the CPU.
+__attribute__((target("avx2"))) auto evaluateAvx2(uint16_t const *hardTotals, uint16_t const *aces,
+                                                  uint16_t *values, std::size_t count) noexcept -> std::size_t
+{
+    const auto bonus = _mm256_set1_epi16(static_cast<short>(HandState::soft_ace_bonus));
+    const auto softLimit = _mm256_set1_epi16(static_cast<short>(HandState::max_soft_hard_total + 1));
+    const auto zero = _mm256_setzero_si256();
+
+    std::size_t i = 0;
+    for (; i + avx2_lanes <= count; i += avx2_lanes)
+    {
+        // Totals never get near 2^15, so the signed comparisons are safe.
+        const auto hard = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(hardTotals + i));
+        const auto aceCount = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(aces + i));
+        const auto hasAce = _mm256_cmpgt_epi16(aceCount, zero);
+        const auto fits = _mm256_cmpgt_epi16(softLimit, hard);
+        const auto soft = _mm256_and_si256(hasAce, fits);
+        const auto value = _mm256_add_epi16(hard, _mm256_and_si256(soft, bonus));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(values + i), value);
+    }
+    return i;
+}
+#endif
+
+} // namespace
+
+HandBatch::HandBatch(std::size_t hands) : _hardTotals(hands, 0), _aces(hands, 0)
+{
+}
+
+auto HandBatch::size() const noexcept -> std::size_t
+{
+    return _hardTotals.size();
+}
+
+auto HandBatch::clear() noexcept -> void
+{
+    std::fill(_hardTotals.begin(), _hardTotals.end(), uint16_t{0});
+    std::fill(_aces.begin(), _aces.end(), uint16_t{0});
+}
+
+auto HandBatch::addCard(std::size_t hand, CompactCard card) noexcept -> void
+{
+    const auto rank = card.getRank();
+    _hardTotals[hand] = static_cast<uint16_t>(_hardTotals[hand] + hardValue(rank));
+    _aces[hand] = static_cast<uint16_t>(_aces[hand] + static_cast<uint16_t>(rank == Rank::ACE));
+}
+
+auto HandBatch::addCards(CompactCard const *cards) noexcept -> void
+{
+    for (std::size_t hand = 0; hand < size(); ++hand)
+    {
+        addCard(hand, cards[hand]);
+    }
+}
+
+auto HandBatch::getHandValues(std::vector<uint16_t> &values) const -> void
+{
+    if (hasAvx2())
+    {
+        getHandValuesAvx2(values);
+    }
+    else
+    {
+        getHandValuesScalar(values);
+    }
+}
+
+auto HandBatch::getHandValuesScalar(std::vector<uint16_t> &values) const -> void
+{
+    values.resize(size());
+    evaluateScalar(_hardTotals.data(), _aces.data(), values.data(), 0, size());
+}
+
+auto HandBatch::getHandValuesAvx2(std::vector<uint16_t> &values) const -> void
+{
+    values.resize(size());
+    std::size_t done = 0;
+#if BLACKJACK_AVX2_KERNEL
+    if (hasAvx2())
+    {
+        done = evaluateAvx2(_hardTotals.data(), _aces.data(), values.data(), size());
+    }
+#endif
+    // Whatever does not fill a whole register, or everything without AVX2.
+    evaluateScalar(_hardTotals.data(), _aces.data(), values.data(), done, size());
+}
+
+auto HandBatch::hasAvx2() noexcept -> bool
+{
+#if BLACKJACK_AVX2_KERNEL
+    static const bool supported = __builtin_cpu_supports("avx2") != 0;
+    return supported;
+#else
+    return false;
+#endif
+}
+
+} // namespace blackjack
@@ -0,0 +1,52 @@
+/// @brief Structure of arrays storage for evaluating many blackjack hands in lockstep.
+#pragma once
+
+#include "blackjack.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace blackjack
+{
+
+/// @brief Holds the running state of many hands, one column per field.
+///
+/// @details The same state as HandState, but the hard totals and ace counts of all hands are kept in two
+/// contiguous columns of 16 bit lanes. Evaluating the batch is then the same few arithmetic operations
+/// applied to every lane, which maps directly onto SIMD: with AVX2 a single instruction handles
+/// sixteen hands. The AVX2 kernel is selected at runtime, so the binary still runs on CPUs without it.
+class HandBatch
+{
+  private:
+    std::vector<uint16_t> _hardTotals;
+    std::vector<uint16_t> _aces;
+
+  public:
+    /// @brief Creates `hands` empty hands.
+    explicit HandBatch(std::size_t hands);
+
+    [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+    /// @brief Empties every hand, keeping the storage.
+    auto clear() noexcept -> void;
+
+    auto addCard(std::size_t hand, CompactCard card) noexcept -> void;
+
+    /// @brief Deals one card to every hand, `cards` must hold at least `size()` cards.
+    auto addCards(CompactCard const *cards) noexcept -> void;
+
+    /// @brief Writes the value of every hand into `values`, using the fastest kernel the CPU supports.
+    auto getHandValues(std::vector<uint16_t> &values) const -> void;
+
+    /// @brief The portable kernel, branch free so the compiler is free to vectorize it itself.
+    auto getHandValuesScalar(std::vector<uint16_t> &values) const -> void;
+
+    /// @brief The AVX2 kernel, sixteen hands per instruction, falls back to the scalar kernel when
+    /// AVX2 is not available.
+    auto getHandValuesAvx2(std::vector<uint16_t> &values) const -> void;
+
+    /// @brief True when this CPU can run the AVX2 kernel.
+    [[nodiscard]] static auto hasAvx2() noexcept -> bool;
+};
+
+} // namespace blackjack
@@ -1,121 +1,121 @@
 #include "blackjack.hpp"
-#include <algorithm>
-#include <cstddef>
+#include "simulation.hpp"
+#include <cerrno>
+#include <chrono>
 #include <cstdint>
 #include <cstdlib>
 #include <etl.hpp>
+#include <iomanip>
 #include <iostream>
-#include <memory>
-#include <random>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <utility>
 
-namespace blackjack
-{
-
-Card::Card(Rank rank, Suit suit) noexcept : _rank(rank), _suit(suit)
-{
-}
-
-auto Card::getRank() const noexcept -> Rank
-{
-    return _rank;
-}
-
-auto Card::getSuite() const noexcept -> Suit
-{
-    return _suit;
-}
-
-Deck::Deck() noexcept
+auto draw_two_cards(blackjack::Deck &deck, blackjack::Player &entity)
 {
-    for (auto const &suit : SuitIterator())
+    for (int i = 0; i < 2; ++i)
     {
-        for (auto const &rank : RankIterator())
+        if (auto result = deck.drawCard(); result.is_ok())
+        {
+            entity.addCard(std::move(result.ok().value()));
+        }
+        else
         {
-            _cards.emplace_back(std::make_unique<Card>(rank, suit));
+            std::cerr << result.err().value().info() << '\n';
         }
     }
 }
 
-auto Deck::size() -> std::size_t
+/// @brief Parses a whole non negative decimal number, anything else, including overflow, is rejected.
+auto parse_count(char const *text) -> std::optional<uint64_t>
 {
-    return _cards.size();
-}
-
-auto Deck::shuffleDeck() -> void
-{
-    std::random_device random_number;
-    std::mt19937 generator(random_number());
-    std::shuffle(_cards.begin(), _cards.end(), generator);
-}
-
-auto Deck::drawCard() -> Result<UniqueCard, Error>
-{
-    if (_cards.empty())
+    if (*text < '0' || *text > '9')
     {
-        return Result<UniqueCard, Error>(Error::create("Deck is empty", RUNTIME_INFO));
+        return std::nullopt;
     }
-    auto card = std::move(_cards.back());
-    _cards.pop_back();
-    return Result<UniqueCard, Error>(std::move(card));
-}
-
-auto Player::addCard(Deck::UniqueCard &&card) noexcept
-{
-    _hand.emplace_back(std::move(card));
+    char *end = nullptr;
+    errno = 0;
+    const auto value = std::strtoull(text, &end, 10);
+    if (*end != '\0' || errno == ERANGE)
+    {
+        return std::nullopt;
+    }
+    return value;
 }
 
-auto Player::getHandValue() -> uint16_t
+/// @brief Parses `--simulate <hands> [--threads <count>] [--seed <seed>]`.
+auto parse_simulation_options(int argc, char **argv) -> Result<blackjack::SimulationOptions, std::string>
 {
-    constexpr auto best_hand_value = 21;
-    constexpr auto remove_value = 10;
-    constexpr auto hightest_ace_value = 11;
-
-    uint16_t value = 0;
-    uint16_t aces = 0;
-
-    for (const auto &card : this->_hand)
+    blackjack::SimulationOptions options;
+    for (int i = 1; i < argc; ++i)
     {
-        auto cardValue = card->getRank();
-        if (cardValue >= Rank::TEN)
+        const std::string_view flag(argv[i]);
+        if (i + 1 >= argc)
         {
-            cardValue = Rank::TEN;
+            return Result<blackjack::SimulationOptions, std::string>(std::string("Missing value for ").append(flag));
         }
-        else if (cardValue == Rank::ACE)
+        const auto parsed = parse_count(argv[++i]);
+        if (!parsed)
         {
-            aces++;
-            cardValue = static_cast<Rank>(hightest_ace_value);
+            return Result<blackjack::SimulationOptions, std::string>(
+                std::string("Invalid value for ").append(flag).append(": ").append(argv[i]));
+        }
+        const auto value = *parsed;
+        if (flag == "--simulate")
+        {
+            options.hands = value;
+        }
+        else if (flag == "--threads")
+        {
+            options.threads = static_cast<std::size_t>(value);
+        }
+        else if (flag == "--seed")
+        {
+            options.seed = value;
+        }
+        else
+        {
+            return Result<blackjack::SimulationOptions, std::string>(std::string("Unknown option ").append(flag));
         }
-        value += static_cast<uint16_t>(cardValue);
-    }
-
-    while (value > best_hand_value && aces > 0)
-    {
-        value -= remove_value;
-        aces--;
     }
-    return value;
+    return Result<blackjack::SimulationOptions, std::string>(options);
 }
 
-} // namespace blackjack
+auto run_simulation(blackjack::SimulationOptions const &options) -> int
+{
+    const auto start = std::chrono::steady_clock::now();
+    const auto stats = blackjack::simulate(options);
+    const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Hands:     " << stats.hands << '\n';
+    std::cout << "Seed:      " << options.seed << '\n';
+    std::cout << std::fixed << std::setprecision(0);
+    std::cout << "Hands/sec: " << static_cast<double>(stats.hands) / seconds << '\n';
+    std::cout << std::setprecision(4);
+    std::cout << "Win:       " << stats.winRate() * 100.0 << "%\n";
+    std::cout << "Loss:      " << stats.lossRate() * 100.0 << "%\n";
+    std::cout << "Push:      " << stats.pushRate() * 100.0 << "%\n";
+    std::cout << "Blackjack: " << stats.blackjacks << '\n';
+    std::cout << "Doubles:   " << stats.doubles << '\n';
+    std::cout << "Return:    " << stats.returnPerHand() * 100.0 << "% per hand\n";
+    return EXIT_SUCCESS;
+}
 
-auto draw_two_cards(blackjack::Deck &deck, blackjack::Player &entity)
+auto main(int argc, char **argv) -> int
 {
-    for (int i = 0; i < 2; ++i)
+    if (argc > 1)
     {
-        if (auto result = deck.drawCard(); result.is_ok())
+        auto options = parse_simulation_options(argc, argv);
+        if (options.is_err())
         {
-            entity.addCard(std::move(result.ok().value()));
-        }
-        else
-        {
-            std::cerr << result.err().value().info() << '\n';
+            std::cerr << options.err().value() << '\n';
+            std::cerr << "Usage: " << argv[0] << " [--simulate <hands>] [--threads <count>] [--seed <seed>]\n";
+            return EXIT_FAILURE;
         }
+        return run_simulation(options.ok().value());
     }
-}
 
-auto main() -> int
-{
     blackjack::Deck deck;
     deck.shuffleDeck();
 
@@ -0,0 +1,101 @@
+/// @brief Small, fast, seedable random number generators for shuffling.
+///
+/// @details std::mt19937 carries 2.5KB of state and std::random_device is a system call,
+/// neither of which belong in a loop that reshuffles. xoshiro256** has 32 bytes of state,
+/// a handful of instructions per number and passes BigCrush, which is plenty for cards.
+///
+/// @link https://prng.di.unimi.it/
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+namespace blackjack
+{
+
+/// @brief SplitMix64, advances `state` and returns the next well mixed value.
+///
+/// @details Used to expand a single 64 bit seed into a full generator state, and to derive
+/// independent seeds from a base seed and an index.
+[[nodiscard]] inline auto splitMix64(std::uint64_t &state) noexcept -> std::uint64_t
+{
+    state += 0x9E3779B97F4A7C15ULL;
+    auto value = state;
+    value = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31U);
+}
+
+/// @brief The xoshiro256** generator, satisfies UniformRandomBitGenerator so it can be
+/// handed to std::shuffle and the standard distributions.
+class Xoshiro256
+{
+  public:
+    using result_type = std::uint64_t;
+
+  private:
+    std::array<std::uint64_t, 4> _state{};
+
+  private:
+    [[nodiscard]] static constexpr auto rotl(std::uint64_t value, unsigned shift) noexcept -> std::uint64_t
+    {
+        return (value << shift) | (value >> (64U - shift));
+    }
+
+    [[nodiscard]] static auto entropy() noexcept -> std::uint64_t
+    {
+        std::random_device device;
+        return (static_cast<std::uint64_t>(device()) << 32U) ^ device();
+    }
+
+  public:
+    /// @brief Seeds from std::random_device once, for when reproducibility is not needed.
+    Xoshiro256() noexcept : Xoshiro256(entropy())
+    {
+    }
+
+    /// @brief Seeds deterministically, the same seed always produces the same sequence.
+    explicit Xoshiro256(std::uint64_t value) noexcept
+    {
+        seed(value);
+    }
+
+  public:
+    /// @brief Resets the generator to the sequence of the given seed.
+    auto seed(std::uint64_t value) noexcept -> void
+    {
+        for (auto &word : _state)
+        {
+            word = splitMix64(value);
+        }
+    }
+
+    [[nodiscard]] static constexpr auto min() noexcept -> result_type
+    {
+        return std::numeric_limits<result_type>::min();
+    }
+
+    [[nodiscard]] static constexpr auto max() noexcept -> result_type
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    auto operator()() noexcept -> result_type
+    {
+        const auto result = rotl(_state[1] * 5U, 7U) * 9U;
+        const auto shifted = _state[1] << 17U;
+
+        _state[2] ^= _state[0];
+        _state[3] ^= _state[1];
+        _state[1] ^= _state[2];
+        _state[0] ^= _state[3];
+        _state[2] ^= shifted;
+        _state[3] = rotl(_state[3], 45U);
+
+        return result;
+    }
+};
+
+} // namespace blackjack
@@ -0,0 +1,130 @@
+/// @brief A multi deck shoe, as dealt in casinos.
+#pragma once
+
+#include "blackjack.hpp"
+#include "random.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <etl.hpp>
+
+namespace blackjack
+{
+
+/// @brief Holds `DeckCount` decks contiguously and deals from them until the cut card comes out.
+///
+/// @details Keeps a count of the cards left per rank, and a Hi-Lo running count, both updated in O(1)
+/// on every draw, so card counting strategies never have to scan the shoe.
+template <std::size_t DeckCount> class Shoe
+{
+  public:
+    static constexpr std::size_t card_count = CompactDeck::card_count * DeckCount;
+
+  private:
+    using RankIterator = EnumerationIterator<Rank, Rank::ACE, Rank::KING>;
+    using SuitIterator = EnumerationIterator<Suit, Suit::HEARTS, Suit::SPADES>;
+
+    /// @brief Hi-Lo card counting tags, indexed by rank: 2-6 are +1, 7-9 are 0, tens and aces are -1.
+    static constexpr std::array<std::int8_t, 14> hi_lo{0, -1, 1, 1, 1, 1, 1, 0, 0, 0, -1, -1, -1, -1};
+
+    /// @brief Where the cut card goes for a penetration clamped to [0, 1], NaN counts as 0.
+    [[nodiscard]] static auto cutCardFor(double penetration) noexcept -> std::size_t
+    {
+        const auto clamped = penetration > 0.0 ? std::min(penetration, 1.0) : 0.0;
+        return card_count - static_cast<std::size_t>(static_cast<double>(card_count) * clamped);
+    }
+
+  private:
+    /// @brief Cards are dealt from the back, everything at or above `_remaining` has been dealt.
+    std::array<CompactCard, card_count> _cards{};
+    std::size_t _remaining{card_count};
+    std::size_t _cutCard;
+    EnumArray<Rank, Rank::ACE, Rank::KING, std::uint16_t> _rankCounts{};
+    std::int32_t _runningCount{0};
+    Xoshiro256 _generator;
+
+  public:
+    /// @brief Builds and shuffles the shoe.
+    ///
+    /// @param `seed` seed for the shuffle generator, the same seed always deals the same cards.
+    /// @param `penetration` fraction of the shoe dealt before the cut card comes out, clamped to [0, 1].
+    explicit Shoe(std::uint64_t seed, double penetration = 0.75) noexcept
+        : _cutCard(cutCardFor(penetration)), _generator(seed)
+    {
+        std::size_t index = 0;
+        for (std::size_t deck = 0; deck < DeckCount; ++deck)
+        {
+            for (auto const &suit : SuitIterator())
+            {
+                for (auto const &rank : RankIterator())
+                {
+                    _cards[index++] = CompactCard(rank, suit);
+                }
+            }
+        }
+        shuffle();
+    }
+
+  public:
+    /// @brief Gathers every dealt card back into the shoe, shuffles, and resets the counts.
+    auto shuffle() -> void
+    {
+        _remaining = card_count;
+        std::shuffle(_cards.begin(), _cards.end(), _generator);
+        for (auto &count : _rankCounts)
+        {
+            count = static_cast<std::uint16_t>(4 * DeckCount);
+        }
+        _runningCount = 0;
+    }
+
+    /// @brief True once the cut card has come out, the shoe should be shuffled before the next round.
+    [[nodiscard]] auto needsShuffle() const noexcept -> bool
+    {
+        return _remaining <= _cutCard;
+    }
+
+    /// @brief Deals the next card, updating the per rank counts and the running count.
+    ///
+    /// @returns Result<CompactCard, StaticError>
+    [[nodiscard]] auto drawCard() -> Result<CompactCard, StaticError>
+    {
+        if (_remaining == 0)
+        {
+            return Result<CompactCard, StaticError>(errors::shoe_empty);
+        }
+        const auto card = _cards[--_remaining];
+        const auto rank = card.getRank();
+        --_rankCounts[rank];
+        _runningCount += hi_lo[static_cast<std::size_t>(rank)];
+        return Result<CompactCard, StaticError>(card);
+    }
+
+    /// @brief How many cards are left in the shoe
+    [[nodiscard]] auto size() const noexcept -> std::size_t
+    {
+        return _remaining;
+    }
+
+    /// @brief How many cards of the given rank are left in the shoe
+    [[nodiscard]] auto remaining(Rank rank) const noexcept -> std::uint16_t
+    {
+        return _rankCounts[rank];
+    }
+
+    /// @brief The Hi-Lo running count of every card dealt since the last shuffle.
+    [[nodiscard]] auto runningCount() const noexcept -> std::int32_t
+    {
+        return _runningCount;
+    }
+
+    /// @brief The running count per deck left in the shoe, what betting decisions are based on.
+    [[nodiscard]] auto trueCount() const noexcept -> double
+    {
+        const auto decksLeft = static_cast<double>(_remaining) / static_cast<double>(CompactDeck::card_count);
+        return decksLeft > 0.0 ? static_cast<double>(_runningCount) / decksLeft : 0.0;
+    }
+};
+
+} // namespace blackjack
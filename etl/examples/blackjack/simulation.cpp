@@ -0,0 +1,249 @@
+#include "simulation.hpp"
+#include "blackjack.hpp"
+#include "random.hpp"
+#include "shoe.hpp"
+#include "strategy.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace blackjack
+{
+
+namespace
+{
+
+/// @brief Hands per block, small enough to balance across threads and large enough
+/// that reseeding the generator is noise.
+constexpr std::uint64_t hands_per_block = 4096;
+
+/// @brief Casino style six deck shoe, shuffled once three quarters of it has been dealt.
+constexpr std::size_t decks_per_shoe = 6;
+constexpr double penetration = 0.75;
+
+constexpr uint16_t blackjack_value = 21;
+constexpr uint16_t dealer_stands_on = 17;
+
+/// @brief Payouts in half bets.
+constexpr std::int64_t half_bets_per_bet = 2;
+constexpr std::int64_t half_bets_per_blackjack = 3;
+
+/// @brief Derives the seed of a block, decorrelating neighbouring blocks.
+auto mixSeed(std::uint64_t seed, std::uint64_t block) noexcept -> std::uint64_t
+{
+    std::uint64_t state = seed + (block * 0x9E3779B97F4A7C15ULL);
+    return splitMix64(state);
+}
+
+/// @brief State of one block, every block gets its own shoe, which owns its own generator.
+class Table
+{
+  private:
+    Shoe<decks_per_shoe> _shoe;
+    CompactPlayer _player;
+    CompactPlayer _dealer;
+
+  private:
+    /// @brief Running dry mid round can only happen with a very deep cut, the shoe is reshuffled.
+    auto draw() -> CompactCard
+    {
+        auto result = _shoe.drawCard();
+        if (result.is_err())
+        {
+            _shoe.shuffle();
+            result = _shoe.drawCard();
+        }
+        return result.ok().value();
+    }
+
+    auto playHand(SimulationStats &stats) -> void
+    {
+        if (_shoe.needsShuffle())
+        {
+            _shoe.shuffle();
+        }
+
+        _player.clear();
+        _dealer.clear();
+        _player.addCard(draw());
+        _dealer.addCard(draw());
+        _player.addCard(draw());
+        _dealer.addCard(draw());
+
+        ++stats.hands;
+        const auto playerNatural = _player.getHandValue() == blackjack_value;
+        const auto dealerNatural = _dealer.getHandValue() == blackjack_value;
+        if (playerNatural || dealerNatural)
+        {
+            if (playerNatural && dealerNatural)
+            {
+                ++stats.pushes;
+            }
+            else if (playerNatural)
+            {
+                ++stats.wins;
+                ++stats.blackjacks;
+                stats.netHalfBets += half_bets_per_blackjack;
+            }
+            else
+            {
+                ++stats.losses;
+                stats.netHalfBets -= half_bets_per_bet;
+            }
+            return;
+        }
+
+        const auto upcard = _dealer.getFirstCard().getValue();
+        auto stake = half_bets_per_bet;
+        auto canDouble = true;
+        for (auto action = basicStrategy(_player.getHandValue(), _player.isSoft(), upcard, canDouble);
+             action != Action::STAND;
+             action = basicStrategy(_player.getHandValue(), _player.isSoft(), upcard, canDouble))
+        {
+            _player.addCard(draw());
+            canDouble = false;
+            if (action == Action::DOUBLE)
+            {
+                stake *= 2;
+                ++stats.doubles;
+                break;
+            }
+            if (_player.getHandValue() > blackjack_value)
+            {
+                break;
+            }
+        }
+        const auto playerValue = _player.getHandValue();
+        if (playerValue > blackjack_value)
+        {
+            ++stats.losses;
+            stats.netHalfBets -= stake;
+            return;
+        }
+
+        while (_dealer.getHandValue() < dealer_stands_on)
+        {
+            _dealer.addCard(draw());
+        }
+        const auto dealerValue = _dealer.getHandValue();
+        if (dealerValue > blackjack_value || playerValue > dealerValue)
+        {
+            ++stats.wins;
+            stats.netHalfBets += stake;
+        }
+        else if (playerValue < dealerValue)
+        {
+            ++stats.losses;
+            stats.netHalfBets -= stake;
+        }
+        else
+        {
+            ++stats.pushes;
+        }
+    }
+
+  public:
+    /// @brief Builds the shoe of a block, shuffled by a generator seeded from the block index,
+    /// so the block does not depend on which thread plays it or what that thread played before.
+    Table(std::uint64_t seed, std::uint64_t block) noexcept : _shoe(mixSeed(seed, block), penetration)
+    {
+    }
+
+    auto play(std::uint64_t hands, SimulationStats &stats) -> void
+    {
+        for (std::uint64_t hand = 0; hand < hands; ++hand)
+        {
+            playHand(stats);
+        }
+    }
+};
+
+} // namespace
+
+auto SimulationStats::merge(SimulationStats const &other) noexcept -> SimulationStats &
+{
+    hands += other.hands;
+    wins += other.wins;
+    losses += other.losses;
+    pushes += other.pushes;
+    blackjacks += other.blackjacks;
+    doubles += other.doubles;
+    netHalfBets += other.netHalfBets;
+    return *this;
+}
+
+auto SimulationStats::winRate() const noexcept -> double
+{
+    return hands == 0 ? 0.0 : static_cast<double>(wins) / static_cast<double>(hands);
+}
+
+auto SimulationStats::lossRate() const noexcept -> double
+{
+    return hands == 0 ? 0.0 : static_cast<double>(losses) / static_cast<double>(hands);
+}
+
+auto SimulationStats::pushRate() const noexcept -> double
+{
+    return hands == 0 ? 0.0 : static_cast<double>(pushes) / static_cast<double>(hands);
+}
+
+auto SimulationStats::returnPerHand() const noexcept -> double
+{
+    return hands == 0 ? 0.0
+                      : static_cast<double>(netHalfBets) /
+                            (static_cast<double>(half_bets_per_bet) * static_cast<double>(hands));
+}
+
+auto simulate(SimulationOptions const &options) -> SimulationStats
+{
+    const auto blocks = (options.hands + hands_per_block - 1) / hands_per_block;
+    auto threadCount = options.threads;
+    if (threadCount == 0)
+    {
+        threadCount = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+    threadCount = static_cast<std::size_t>(std::min<std::uint64_t>(threadCount, std::max<std::uint64_t>(blocks, 1)));
+
+    std::atomic<std::uint64_t> nextBlock{0};
+    std::vector<SimulationStats> perThread(threadCount);
+
+    // Counters are accumulated on the worker's stack and published once, neighbouring slots of perThread
+    // share cache lines and updating them per hand would bounce those lines between cores.
+    auto worker = [&options, &nextBlock, blocks](SimulationStats &result) {
+        SimulationStats stats;
+        for (auto block = nextBlock.fetch_add(1, std::memory_order_relaxed); block < blocks;
+             block = nextBlock.fetch_add(1, std::memory_order_relaxed))
+        {
+            const auto first = block * hands_per_block;
+            const auto hands = std::min(hands_per_block, options.hands - first);
+            Table table(options.seed, block);
+            table.play(hands, stats);
+        }
+        result = stats;
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (std::size_t i = 1; i < threadCount; ++i)
+    {
+        threads.emplace_back(worker, std::ref(perThread[i]));
+    }
+    worker(perThread[0]);
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    SimulationStats total;
+    for (auto const &stats : perThread)
+    {
+        total.merge(stats);
+    }
+    return total;
+}
+
+} // namespace blackjack
@@ -0,0 +1,55 @@
+/// @brief A multithreaded Monte Carlo blackjack simulation built on the compact
+/// value semantic cards, usable as a realistic load generator.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace blackjack
+{
+
+/// @brief Outcome counters for a batch of simulated hands, from the players point of view.
+class SimulationStats
+{
+  public:
+    std::uint64_t hands{0};
+    std::uint64_t wins{0};
+    std::uint64_t losses{0};
+    std::uint64_t pushes{0};
+    std::uint64_t blackjacks{0};
+    std::uint64_t doubles{0};
+
+    /// @brief Net winnings in half bets, so a blackjack paying 3 to 2 stays an integer.
+    std::int64_t netHalfBets{0};
+
+  public:
+    /// @brief Adds the counters of another batch, merging is order independent.
+    auto merge(SimulationStats const &other) noexcept -> SimulationStats &;
+
+    [[nodiscard]] auto winRate() const noexcept -> double;
+    [[nodiscard]] auto lossRate() const noexcept -> double;
+    [[nodiscard]] auto pushRate() const noexcept -> double;
+
+    /// @brief Expected net return per hand, in units of the initial bet.
+    [[nodiscard]] auto returnPerHand() const noexcept -> double;
+};
+
+class SimulationOptions
+{
+  public:
+    std::uint64_t hands{1'000'000};
+    std::uint64_t seed{0x5EED};
+
+    /// @brief Zero uses one thread per hardware thread.
+    std::size_t threads{0};
+};
+
+/// @brief Plays `options.hands` hands of player versus dealer across a pool of threads, the player
+/// following table driven basic strategy.
+///
+/// @details Hands are split into fixed size blocks, and every block is seeded from the simulation seed and
+/// the block index alone. Each thread owns its own deck and generator and plays whichever block is next, so
+/// the merged statistics are identical for a given seed no matter how many threads are used.
+[[nodiscard]] auto simulate(SimulationOptions const &options) -> SimulationStats;
+
+} // namespace blackjack
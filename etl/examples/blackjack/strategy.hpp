@@ -0,0 +1,133 @@
+/// @brief Table driven basic strategy for the simulator.
+///
+/// @details Multi deck, dealer stands on soft 17, no splitting (pairs are played as their total).
+/// The whole decision space is small enough to precompute, so choosing a play is a single
+/// array load instead of a chain of comparisons.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace blackjack
+{
+
+enum class Action : std::uint8_t
+{
+    HIT,
+    STAND,
+    DOUBLE,
+};
+
+namespace strategy
+{
+
+/// @brief Dealer up cards run from 2 to 11 (ace), player totals from 0 to 21.
+constexpr std::size_t upcard_count = 10;
+constexpr std::size_t total_count = 22;
+constexpr std::size_t lowest_upcard = 2;
+
+using Table = std::array<std::array<std::array<std::array<Action, upcard_count>, total_count>, 2>, 2>;
+
+/// @brief The textbook play, `canDouble` is false once the hand holds more than two cards.
+[[nodiscard]] constexpr auto decide(std::size_t total, bool soft, std::size_t upcard, bool canDouble) noexcept
+    -> Action
+{
+    const auto doubleOr = [canDouble](Action fallback) { return canDouble ? Action::DOUBLE : fallback; };
+    const auto between = [upcard](std::size_t low, std::size_t high) { return upcard >= low && upcard <= high; };
+
+    if (soft)
+    {
+        if (total >= 19)
+        {
+            return Action::STAND;
+        }
+        if (total == 18)
+        {
+            if (between(3, 6))
+            {
+                return doubleOr(Action::STAND);
+            }
+            return between(2, 8) ? Action::STAND : Action::HIT;
+        }
+        if (total == 17)
+        {
+            return between(3, 6) ? doubleOr(Action::HIT) : Action::HIT;
+        }
+        if (total >= 15)
+        {
+            return between(4, 6) ? doubleOr(Action::HIT) : Action::HIT;
+        }
+        if (total >= 13)
+        {
+            return between(5, 6) ? doubleOr(Action::HIT) : Action::HIT;
+        }
+        return Action::HIT;
+    }
+
+    if (total >= 17)
+    {
+        return Action::STAND;
+    }
+    if (total >= 13)
+    {
+        return between(2, 6) ? Action::STAND : Action::HIT;
+    }
+    if (total == 12)
+    {
+        return between(4, 6) ? Action::STAND : Action::HIT;
+    }
+    if (total == 11)
+    {
+        return between(2, 10) ? doubleOr(Action::HIT) : Action::HIT;
+    }
+    if (total == 10)
+    {
+        return between(2, 9) ? doubleOr(Action::HIT) : Action::HIT;
+    }
+    if (total == 9)
+    {
+        return between(3, 6) ? doubleOr(Action::HIT) : Action::HIT;
+    }
+    return Action::HIT;
+}
+
+/// @brief Evaluates every decision once, at compile time.
+[[nodiscard]] constexpr auto buildTable() noexcept -> Table
+{
+    Table table{};
+    for (std::size_t canDouble = 0; canDouble < 2; ++canDouble)
+    {
+        for (std::size_t soft = 0; soft < 2; ++soft)
+        {
+            for (std::size_t total = 0; total < total_count; ++total)
+            {
+                for (std::size_t upcard = 0; upcard < upcard_count; ++upcard)
+                {
+                    table[canDouble][soft][total][upcard] =
+                        decide(total, soft != 0, upcard + lowest_upcard, canDouble != 0);
+                }
+            }
+        }
+    }
+    return table;
+}
+
+constexpr Table basic = buildTable();
+
+} // namespace strategy
+
+/// @brief Looks up the basic strategy play.
+///
+/// @param `total` the players hand value, must be 21 or less.
+/// @param `soft` whether an ace in the players hand is counted as eleven.
+/// @param `upcard` the blackjack value of the dealers up card, 2 to 11.
+/// @param `canDouble` whether the player still holds only their first two cards.
+[[nodiscard]] constexpr auto basicStrategy(std::uint16_t total, bool soft, std::uint8_t upcard, bool canDouble) noexcept
+    -> Action
+{
+    return strategy::basic[static_cast<std::size_t>(canDouble)][static_cast<std::size_t>(soft)][total]
+                          [static_cast<std::size_t>(upcard) - strategy::lowest_upcard];
+}
+
+} // namespace blackjack
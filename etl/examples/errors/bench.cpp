@@ -0,0 +1,138 @@
+/// @brief Compares heap allocated etl::Error against etl::pmr::Error carved out of a per request arena,
+/// on one thread and on every hardware thread, where the global allocator is contended, and what
+/// attaching context to an error costs when it is never printed. Built twice, the second time with
+/// ETL_ERROR_BACKTRACE defined, to measure what capturing a backtrace adds to creating an error, and a third
+/// time with ETL_ERROR_SITE_COUNTERS defined, to measure counting errors per RUNTIME_INFO call site against
+/// creating them from a hand built location.
+#include "../benchmark.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <etl.hpp>
+#include <iostream>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace etl;
+
+namespace
+{
+
+constexpr std::size_t requests = 200'000;
+
+/// @brief A request creates a handful of errors, looks at them and throws them away, the messages are too
+/// long for the small string buffer so every one of them allocates.
+constexpr std::array<std::string_view, 6> messages{
+    "Missing required header: authorization", "Request body is not valid JSON",
+    "Field 'quantity' must be a positive number", "Unknown product identifier in line item",
+    "Coupon code has expired for this account", "Shipping address failed postal validation",
+};
+
+template <typename ErrorType> auto handleRequest() -> std::size_t
+{
+    std::size_t inspected = 0;
+    for (auto const &message : messages)
+    {
+        const auto error = ErrorType::create(message, RUNTIME_INFO);
+        inspected += error.view().size();
+    }
+    return inspected;
+}
+
+/// @brief Every thread keeps a buffer for its requests, and a fresh arena over it per request, so nothing
+/// touches the global allocator and dropping the arena frees the whole request at once.
+auto handleRequestInArena() -> std::size_t
+{
+    thread_local std::array<std::byte, 4096> buffer{};
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+    const pmr::ErrorResourceScope scope(&arena);
+    return handleRequest<pmr::Error>();
+}
+
+/// @brief An error passing up through three layers, each attaching context, then handled or printed.
+template <bool Print> auto propagate() -> std::size_t
+{
+    auto error = Error::create("Unexpected end of input", RUNTIME_INFO);
+    error.context("while parsing header", RUNTIME_INFO)
+        .context("while loading request body", RUNTIME_INFO)
+        .context("while handling request", RUNTIME_INFO);
+    if constexpr (Print)
+    {
+        return error.info().size();
+    }
+    else
+    {
+        return error.context_count();
+    }
+}
+
+/// @brief A short message, so creating the error does not allocate and the cost of counting, if any, shows.
+auto runtimeInfoError() -> Error
+{
+    return Error::create("Timeout", RUNTIME_INFO);
+}
+
+auto uncountedError() -> Error
+{
+    return Error::create("Timeout", SourceCodeLocation(__FILE__, __LINE__, "uncountedError"));
+}
+
+} // namespace
+
+auto main() -> int
+{
+#if defined(ETL_ERROR_BACKTRACE)
+    std::cout << "backtrace capture: on, " << ETL_ERROR_BACKTRACE_DEPTH << " frames\n";
+#else
+    std::cout << "backtrace capture: off\n";
+#endif
+#if defined(ETL_ERROR_SITE_COUNTERS)
+    std::cout << "call site counters: on\n";
+#else
+    std::cout << "call site counters: off\n";
+#endif
+
+    const auto hardwareThreads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+
+    std::vector<std::size_t> threadCounts{1};
+    if (hardwareThreads > 1)
+    {
+        threadCounts.push_back(hardwareThreads);
+    }
+
+    for (const auto threads : threadCounts)
+    {
+        std::cout << "-- " << messages.size() << " errors per request, " << threads << " thread(s)\n";
+        bench::runParallel("etl::Error (heap)", threads, requests,
+                           [](std::size_t) { bench::doNotOptimize(handleRequest<Error>()); });
+        bench::runParallel("etl::pmr::Error (default resource)", threads, requests,
+                           [](std::size_t) { bench::doNotOptimize(handleRequest<pmr::Error>()); });
+        bench::runParallel("etl::pmr::Error (request arena)", threads, requests,
+                           [](std::size_t) { bench::doNotOptimize(handleRequestInArena()); });
+    }
+
+    for (const auto threads : threadCounts)
+    {
+        std::cout << "-- one call site, " << threads << " thread(s)\n";
+        bench::runParallel("hand built SourceCodeLocation (uncounted)", threads, requests,
+                           [](std::size_t) { bench::doNotOptimize(uncountedError()); });
+        bench::runParallel("RUNTIME_INFO", threads, requests,
+                           [](std::size_t) { bench::doNotOptimize(runtimeInfoError()); });
+    }
+#if defined(ETL_ERROR_SITE_COUNTERS)
+    for (auto const &site : error_site_counts())
+    {
+        std::cout << site.file << ':' << site.line << ' ' << site.function << ": " << site.count << " errors\n";
+    }
+#endif
+
+    std::cout << "-- error with 3 context frames\n";
+    bench::run("handled without printing", requests, [] { bench::doNotOptimize(propagate<false>()); });
+    bench::run("formatted with info()", requests, [] { bench::doNotOptimize(propagate<true>()); });
+
+    return EXIT_SUCCESS;
+}
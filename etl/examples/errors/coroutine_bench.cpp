@@ -0,0 +1,112 @@
+/// @brief Propagating errors by `co_await`ing Results versus checking is_err() after every call, and how
+/// many heap allocations either way costs.
+///
+/// @details Built as C++20, every global allocation is counted so the coroutine frames can be seen not to
+/// come from the heap.
+#include "../benchmark.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <etl.hpp>
+#include <iostream>
+#include <new>
+
+using namespace etl;
+
+namespace
+{
+
+std::atomic<std::size_t> allocations{0};
+
+constexpr std::size_t iterations = 10'000'000;
+
+const auto not_a_digit = StaticError::create("Not a digit", 22);
+
+/// @brief Opaque to the optimizer, so neither version is folded away.
+volatile char digits[3] = {'4', '2', '7'};
+
+[[gnu::noinline]] auto parseDigit(char digit) noexcept -> Result<int32_t, StaticError>
+{
+    if (digit < '0' || digit > '9')
+    {
+        return Result<int32_t, StaticError>(not_a_digit);
+    }
+    return Result<int32_t, StaticError>(digit - '0');
+}
+
+auto parseManually() noexcept -> Result<int32_t, StaticError>
+{
+    const auto hundreds = parseDigit(digits[0]);
+    if (hundreds.is_err())
+    {
+        return Result<int32_t, StaticError>(hundreds.err().value());
+    }
+    const auto tens = parseDigit(digits[1]);
+    if (tens.is_err())
+    {
+        return Result<int32_t, StaticError>(tens.err().value());
+    }
+    const auto ones = parseDigit(digits[2]);
+    if (ones.is_err())
+    {
+        return Result<int32_t, StaticError>(ones.err().value());
+    }
+    return Result<int32_t, StaticError>(hundreds.ok().value() * 100 + tens.ok().value() * 10 + ones.ok().value());
+}
+
+#if ETL_HAS_COROUTINES
+auto parseWithCoroutine() -> Result<int32_t, StaticError>
+{
+    const int32_t hundreds = co_await parseDigit(digits[0]);
+    const int32_t tens = co_await parseDigit(digits[1]);
+    const int32_t ones = co_await parseDigit(digits[2]);
+    co_return hundreds * 100 + tens * 10 + ones;
+}
+#endif
+
+template <typename Function> auto measure(char const *name, Function &&parse) -> void
+{
+    const auto before = allocations.load(std::memory_order_relaxed);
+    bench::run(name, iterations, [&parse] { bench::doNotOptimize(parse().is_ok()); });
+    std::cout << "    heap allocations: " << (allocations.load(std::memory_order_relaxed) - before) << '\n';
+}
+
+} // namespace
+
+auto operator new(std::size_t size) -> void *
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *memory = std::malloc(size))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+auto operator delete(void *memory) noexcept -> void
+{
+    std::free(memory);
+}
+
+auto operator delete(void *memory, std::size_t /*size*/) noexcept -> void
+{
+    std::free(memory);
+}
+
+auto main() -> int
+{
+#if ETL_HAS_COROUTINES
+    std::cout << "-- three digits, all valid\n";
+    measure("is_err() after every call", parseManually);
+    measure("co_await", parseWithCoroutine);
+
+    std::cout << "-- the second digit is invalid\n";
+    digits[1] = 'x';
+    measure("is_err() after every call", parseManually);
+    measure("co_await", parseWithCoroutine);
+#else
+    std::cout << "Awaiting a Result needs C++20 coroutines\n";
+#endif
+    return EXIT_SUCCESS;
+}
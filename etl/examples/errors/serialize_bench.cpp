@@ -0,0 +1,60 @@
+/// @brief Cost of moving an error to another process as etl's binary encoding versus as the text
+/// `info()` formats, and of reading it back on the other side.
+#include "../benchmark.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <etl.hpp>
+#include <iostream>
+#include <string>
+
+using namespace etl;
+
+namespace
+{
+
+constexpr std::size_t iterations = 1'000'000;
+
+auto failingCall() -> Error
+{
+    return Error::create("Upstream service returned 503", RUNTIME_INFO).context("while refreshing the cache");
+}
+
+} // namespace
+
+auto main() -> int
+{
+    const auto error = failingCall();
+    std::array<std::byte, 512> buffer{};
+
+    std::cout << "-- encoding one error with a location and a context frame, "
+              << serialized_size(error) << " bytes binary, " << error.info().size() << " bytes text\n";
+    bench::run("info() into a buffer", iterations, [&] {
+        const auto text = error.info();
+        std::memcpy(buffer.data(), text.data(), std::min(text.size(), buffer.size()));
+        bench::doNotOptimize(buffer);
+    });
+    bench::run("serialize_into()", iterations, [&] {
+        bench::doNotOptimize(serialize_into(error, Span<std::byte>(buffer)).ok().value());
+    });
+
+    std::cout << "-- decoding it\n";
+    static_cast<void>(serialize_into(error, Span<std::byte>(buffer)));
+    bench::run("deserialize<Error>()", iterations, [&] {
+        const auto view = deserialize<Error>(Span<std::byte const>(buffer));
+        bench::doNotOptimize(view.ok()->view().size());
+    });
+
+    std::cout << "-- a Result<uint64_t, StaticError> reply\n";
+    using Reply = Result<uint64_t, StaticError>;
+    const Reply reply(uint64_t{42});
+    bench::run("std::to_string()", iterations, [&] { bench::doNotOptimize(std::to_string(reply.ok().value())); });
+    bench::run("serialize_into() + deserialize()", iterations, [&] {
+        static_cast<void>(serialize_into(reply, Span<std::byte>(buffer)));
+        bench::doNotOptimize(deserialize<Reply>(Span<std::byte const>(buffer)).ok()->ok().value());
+    });
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,50 @@
+/// @brief Latency, as seen by the thread that hit the error, of reporting it directly with
+/// `std::cerr << error.info()` versus handing it to an etl::ErrorSink.
+///
+/// @details Both write to stderr, run it as `etl-error-sink-bench 2>/dev/null` or redirect stderr to a
+/// file to keep the terminal out of the numbers.
+#include "../benchmark.hpp"
+#include <cstddef>
+#include <cstdlib>
+#include <etl.hpp>
+#include <iostream>
+#if ETL_HAS_ERROR_SINK
+#include <unistd.h>
+#endif
+
+using namespace etl;
+
+namespace
+{
+
+constexpr std::size_t errors = 100'000;
+
+auto failingCall() -> Error
+{
+    return Error::create("Upstream service returned 503", RUNTIME_INFO).context("while refreshing the cache");
+}
+
+} // namespace
+
+auto main() -> int
+{
+#if ETL_HAS_ERROR_SINK
+    std::cout << "-- reporting " << errors << " errors\n";
+    bench::latency("std::cerr << error.info()", errors, [] { std::cerr << failingCall().info() << '\n'; });
+
+    {
+        ErrorSink sink(STDERR_FILENO, errors, OverflowPolicy::Block);
+        bench::latency("ErrorSink::push (block)", errors, [&sink] { sink.push(failingCall()); });
+        sink.shutdown();
+    }
+    {
+        ErrorSink sink(STDERR_FILENO, 1024, OverflowPolicy::Drop);
+        bench::latency("ErrorSink::push (drop, 1024 slots)", errors, [&sink] { sink.push(failingCall()); });
+        sink.shutdown();
+        std::cout << "dropped " << sink.dropped() << " of " << errors << '\n';
+    }
+#else
+    std::cout << "ErrorSink needs POSIX write() and ETL_ERROR_SINK defined\n";
+#endif
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,193 @@
+/// @brief Algorithms over many Results. Gathering a vector of values with etl::collect versus the loop
+/// people write by hand, counting how many times each value is copied on the way, and validating ten
+/// million records with etl::transform_results on every worker count up to the hardware threads. Then a
+/// million Results processed one by one versus as an etl::ResultBatch.
+#include "../benchmark.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <etl.hpp>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace etl;
+
+namespace
+{
+
+constexpr std::size_t records = 100'000;
+constexpr std::size_t rounds = 20;
+constexpr std::size_t validated_records = 10'000'000;
+constexpr std::size_t batch_results = 1'000'000;
+
+std::size_t copies = 0;
+
+/// @brief A parsed record, big enough that copying it is not free, counting its copies.
+class Record
+{
+  public:
+    std::string name;
+    uint64_t id{0};
+
+    Record(std::string recordName, uint64_t recordId) : name(std::move(recordName)), id(recordId)
+    {
+    }
+
+    ~Record() = default;
+    Record(Record &&other) noexcept = default;
+    auto operator=(Record &&other) noexcept -> Record & = default;
+    Record(Record const &other) : name(other.name), id(other.id)
+    {
+        ++copies;
+    }
+    auto operator=(Record const &other) -> Record &
+    {
+        ++copies;
+        name = other.name;
+        id = other.id;
+        return *this;
+    }
+};
+
+auto parse(uint64_t id) -> Result<Record, StaticError>
+{
+    if (id == records)
+    {
+        return Result<Record, StaticError>(StaticError::create("Unexpected end of input"));
+    }
+    return Result<Record, StaticError>(Record("customer record number " + std::to_string(id), id));
+}
+
+auto handWritten(std::vector<uint64_t> const &ids) -> Result<std::vector<Record>, StaticError>
+{
+    std::vector<Record> parsed;
+    for (const auto id : ids)
+    {
+        const auto result = parse(id);
+        if (result.is_err())
+        {
+            return Result<std::vector<Record>, StaticError>(result.err().value());
+        }
+        parsed.push_back(result.ok().value());
+    }
+    return Result<std::vector<Record>, StaticError>(std::move(parsed));
+}
+
+/// @brief A raw record as it arrives, a packed age and postal code, and what validating it produces.
+class Validated
+{
+  public:
+    uint32_t age{0};
+    uint32_t postal_code{0};
+};
+
+auto validate(uint64_t const &raw) -> Result<Validated, StaticError>
+{
+    const auto age = static_cast<uint32_t>(raw >> 32U);
+    const auto postal_code = static_cast<uint32_t>(raw);
+    if (age > 150)
+    {
+        return Result<Validated, StaticError>(StaticError::create("Age out of range", 1));
+    }
+    if (postal_code < 1000 || postal_code > 99'999)
+    {
+        return Result<Validated, StaticError>(StaticError::create("Postal code out of range", 2));
+    }
+    return Result<Validated, StaticError>(Validated{age, postal_code});
+}
+
+template <typename Function> auto measure(char const *name, Function &&func) -> void
+{
+    copies = 0;
+    bench::run(name, rounds, func);
+    std::cout << "    copies per record: " << static_cast<double>(copies) / static_cast<double>(rounds * records)
+              << '\n';
+}
+
+} // namespace
+
+auto main() -> int
+{
+    std::vector<uint64_t> ids(records);
+    for (std::size_t index = 0; index < records; ++index)
+    {
+        ids[index] = index;
+    }
+
+    std::cout << "-- gathering " << records << " parsed records\n";
+    measure("hand written loop over ok().value()", [&ids] { bench::doNotOptimize(handWritten(ids).is_ok()); });
+    measure("etl::collect", [&ids] { bench::doNotOptimize(collect(ids, parse).is_ok()); });
+
+    std::vector<uint64_t> raw(validated_records);
+    uint64_t state = 1;
+    for (auto &record : raw)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        record = ((state >> 33U) % 160) << 32U | ((state >> 13U) % 100'000);
+    }
+    std::vector<Validated> validated(raw.size());
+
+    std::cout << "-- validating " << validated_records << " records\n";
+    const auto hardware = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    double single = 0;
+    for (std::size_t threads = 1;; threads = std::min(threads * 2, hardware))
+    {
+        ThreadPool pool(threads);
+        std::size_t errors = 0;
+        const auto nanos = bench::run("transform_results, " + std::to_string(threads) + " worker(s)", 1, [&] {
+            errors = transform_results(pool, Span<uint64_t const>(raw), Span<Validated>(validated), validate)
+                         .error_count();
+        });
+        single = threads == 1 ? nanos : single;
+        std::cout << "    " << nanos / static_cast<double>(validated_records) << " ns per record, " << errors
+                  << " errors, speedup " << single / nanos << "x\n";
+        if (threads == hardware)
+        {
+            break;
+        }
+    }
+
+    std::cout << "-- " << batch_results << " results, one in a thousand failed\n";
+    std::vector<Result<double, Error>> rows;
+    ResultBatch<double, Error> batch;
+    rows.reserve(batch_results);
+    batch.reserve(batch_results);
+    for (std::size_t index = 0; index < batch_results; ++index)
+    {
+        auto result = index % 1000 == 999 ? Result<double, Error>(Error::create("Sensor offline"))
+                                          : Result<double, Error>(static_cast<double>(index) * 0.5);
+        rows.push_back(result);
+        batch.push(std::move(result));
+    }
+    std::cout << "    " << sizeof(Result<double, Error>) << " bytes per row versus "
+              << sizeof(double) << " bytes and a bit per lane\n";
+
+    bench::run("rows: scale every ok value", rounds, [&rows] {
+        for (auto &row : rows)
+        {
+            if (row.is_ok())
+            {
+                row = Result<double, Error>(row.ok().value() * 1.8 + 32.0);
+            }
+        }
+        bench::doNotOptimize(rows.data());
+    });
+    bench::run("batch: map over the value column", rounds, [&batch] {
+        batch = batch.map([](double value) { return value * 1.8 + 32.0; });
+        bench::doNotOptimize(batch.values().data());
+    });
+    bench::run("rows: count errors", rounds, [&rows] {
+        std::size_t errors = 0;
+        for (auto const &row : rows)
+        {
+            errors += row.is_err() ? 1U : 0U;
+        }
+        bench::doNotOptimize(errors);
+    });
+    bench::run("batch: popcount the validity bitmap", rounds,
+               [&batch] { bench::doNotOptimize(batch.error_count()); });
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,94 @@
+/// @brief Throughput and latency of etl::ThreadPool across worker counts: independent tasks gathered with
+/// when_all, a recursive fan-out that spawns from inside the pool and relies on stealing, and the round
+/// trip of a single spawn().get().
+#include "../benchmark.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <etl.hpp>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace etl;
+
+namespace
+{
+
+constexpr std::size_t tasks_per_round = 10'000;
+constexpr std::size_t rounds = 20;
+constexpr std::size_t round_trips = 20'000;
+
+/// @brief A sub-call worth putting on a pool, a few hundred nanoseconds of arithmetic.
+auto subCall(uint64_t seed) -> Result<uint64_t, StaticError>
+{
+    for (int i = 0; i < 64; ++i)
+    {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    }
+    if (seed % 1000 == 0)
+    {
+        return Result<uint64_t, StaticError>(StaticError::create("Sub-call failed", 1));
+    }
+    return Result<uint64_t, StaticError>(seed >> 32U);
+}
+
+auto fanOut(ThreadPool &pool, uint64_t first, uint64_t last) -> uint64_t
+{
+    if (last - first <= 16)
+    {
+        uint64_t sum = 0;
+        for (auto seed = first; seed < last; ++seed)
+        {
+            sum += subCall(seed).is_ok() ? 1U : 0U;
+        }
+        return sum;
+    }
+    const auto middle = first + (last - first) / 2;
+    auto left = pool.spawn([&pool, first, middle] { return fanOut(pool, first, middle); });
+    const auto right = fanOut(pool, middle, last);
+    return left.get() + right;
+}
+
+auto workerCounts() -> std::vector<std::size_t>
+{
+    const auto hardware = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    std::vector<std::size_t> counts;
+    for (std::size_t threads = 1; threads < hardware; threads *= 2)
+    {
+        counts.push_back(threads);
+    }
+    counts.push_back(hardware);
+    return counts;
+}
+
+} // namespace
+
+auto main() -> int
+{
+    for (const auto threads : workerCounts())
+    {
+        ThreadPool pool(threads);
+        std::cout << "-- " << threads << " worker(s)\n";
+
+        const auto perRound = bench::run("spawn + when_all, per round", rounds, [&pool] {
+            std::vector<Task<Result<uint64_t, StaticError>>> tasks;
+            tasks.reserve(tasks_per_round);
+            for (std::size_t seed = 0; seed < tasks_per_round; ++seed)
+            {
+                tasks.push_back(pool.spawn([seed] { return subCall(seed); }));
+            }
+            bench::doNotOptimize(when_all(std::move(tasks)).get().size());
+        });
+        std::cout << "    " << perRound / static_cast<double>(tasks_per_round) << " ns per task\n";
+
+        bench::run("recursive fan-out of 16k sub-calls", rounds, [&pool] {
+            bench::doNotOptimize(pool.spawn([&pool] { return fanOut(pool, 0, 16'384); }).get());
+        });
+
+        bench::latency("spawn().get() round trip", round_trips,
+                       [&pool] { bench::doNotOptimize(pool.spawn([] { return subCall(7); }).get().is_ok()); });
+    }
+    return EXIT_SUCCESS;
+}
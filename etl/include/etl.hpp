@@ -27,15 +27,70 @@
 
 #if __cplusplus >= 201702L
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
 #include <functional>
+#include <iterator>
+#include <limits>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <numeric>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <system_error>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <variant>
+#include <vector>
+
+/// @brief Define ETL_ERROR_SINK before including etl.hpp to get etl::ErrorSink. It writes to a file descriptor
+/// with POSIX write(), so only translation units that ask for it pull in <unistd.h>.
+#if defined(ETL_ERROR_SINK)
+#if __has_include(<unistd.h>)
+#include <cerrno>
+#include <unistd.h>
+#define ETL_HAS_ERROR_SINK 1
+#else
+#error "ETL_ERROR_SINK needs write() from <unistd.h>"
+#endif
+#else
+#define ETL_HAS_ERROR_SINK 0
+#endif
+
+/// @brief Coroutines returning a Result hand their caller an object that is converted to the Result after the
+/// coroutine has run, which Clang only does from version 16 on.
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>) && !(defined(__clang__) && __clang_major__ < 16)
+#include <coroutine>
+#define ETL_HAS_COROUTINES 1
+#else
+#define ETL_HAS_COROUTINES 0
+#endif
+
+/// @brief Define ETL_ERROR_BACKTRACE before including etl.hpp, in every translation unit, to have each Error
+/// record the raw return addresses of its creation. Without it no capture code is compiled at all.
+#if defined(ETL_ERROR_BACKTRACE)
+#if __has_include(<execinfo.h>)
+#include <cstdlib>
+#include <execinfo.h>
+#else
+#error "ETL_ERROR_BACKTRACE needs backtrace() from <execinfo.h>"
+#endif
+#ifndef ETL_ERROR_BACKTRACE_DEPTH
+#define ETL_ERROR_BACKTRACE_DEPTH 32
+#endif
+#endif
 
 namespace etl
 {
@@ -46,9 +101,204 @@ constexpr int VERSION_PATCH = 0;
 constexpr int VERSION = (VERSION_MAJOR * 10000) + (VERSION_MINOR * 100) + VERSION_PATCH;
 constexpr std::string_view VERSION_STRING = "0.7.0";
 
+/// @brief Implementation details, not part of the public interface.
+namespace internal
+{
+
+/// @brief Counts the number of set bits, lowers to a single popcnt instruction where available.
+[[nodiscard]] constexpr auto popcount(std::uint64_t bits) noexcept -> std::uint32_t
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<std::uint32_t>(__builtin_popcountll(bits));
+#else
+    std::uint32_t count = 0;
+    for (; bits != 0; bits &= bits - 1)
+    {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+/// @brief Index of the lowest set bit, `bits` must not be zero.
+[[nodiscard]] constexpr auto countr_zero(std::uint64_t bits) noexcept -> std::uint32_t
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<std::uint32_t>(__builtin_ctzll(bits));
+#else
+    std::uint32_t count = 0;
+    for (; (bits & 1U) == 0; bits >>= 1U)
+    {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+/// @brief Offset of an enumerator from the first enumerator of a contiguous range.
+///
+/// @details Values below `beginValue` wrap around to a very large offset, so a single
+/// unsigned comparison against the range size covers both ends of the range.
+template <typename EnumType>
+[[nodiscard]] constexpr auto enum_offset(EnumType value, EnumType beginValue) noexcept -> std::size_t
+{
+    return static_cast<std::size_t>(static_cast<std::int64_t>(value) - static_cast<std::int64_t>(beginValue));
+}
+
+/// @brief Joins every thread it holds when it goes out of scope, so an exception thrown while threads are
+/// running unwinds past them instead of destroying a joinable std::thread, which would terminate.
+class ThreadJoiner
+{
+  private:
+    std::vector<std::thread> &_threads;
+
+  public:
+    explicit ThreadJoiner(std::vector<std::thread> &threads) noexcept : _threads(threads)
+    {
+    }
+
+    ~ThreadJoiner()
+    {
+        for (auto &thread : _threads)
+        {
+            if (thread.joinable())
+            {
+                thread.join();
+            }
+        }
+    }
+
+    ThreadJoiner(ThreadJoiner &&other) noexcept = delete;
+    auto operator=(ThreadJoiner &&other) noexcept -> ThreadJoiner & = delete;
+    ThreadJoiner(ThreadJoiner const &other) = delete;
+    auto operator=(ThreadJoiner const &other) -> ThreadJoiner & = delete;
+};
+
+/// @brief Runs `func(index)` for every index in [0, count) across up to `max_threads` threads.
+///
+/// @details The calling thread takes part in the work, indices are handed out through a shared atomic
+/// counter so uneven workloads balance themselves. A `max_threads` of zero means one thread per hardware thread.
+/// If `func` throws, no further indices are handed out, every thread is joined and the first exception is
+/// rethrown on the calling thread. If a thread fails to start, the remaining work runs on the threads that did.
+template <typename Function>
+auto parallel_for_index(std::size_t count, std::size_t max_threads, Function &&func) -> void
+{
+    if (max_threads == 0)
+    {
+        max_threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+    const auto thread_count = std::min(count, max_threads);
+    if (thread_count <= 1)
+    {
+        for (std::size_t index = 0; index < count; ++index)
+        {
+            func(index);
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    std::mutex failureMutex;
+    std::exception_ptr failure;
+    auto worker = [&next, &func, &failureMutex, &failure, count]() noexcept {
+        try
+        {
+            for (auto index = next.fetch_add(1, std::memory_order_relaxed); index < count;
+                 index = next.fetch_add(1, std::memory_order_relaxed))
+            {
+                func(index);
+            }
+        }
+        catch (...)
+        {
+            next.store(count, std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(failureMutex);
+            if (!failure)
+            {
+                failure = std::current_exception();
+            }
+        }
+    };
+
+    {
+        std::vector<std::thread> threads;
+        const ThreadJoiner joiner(threads);
+        threads.reserve(thread_count - 1);
+        for (std::size_t i = 1; i < thread_count; ++i)
+        {
+            try
+            {
+                threads.emplace_back(worker);
+            }
+            catch (std::system_error const &)
+            {
+                break;
+            }
+        }
+        worker();
+    }
+    if (failure)
+    {
+        std::rethrow_exception(failure);
+    }
+}
+
+/// @brief Bitwise helpers used by the ETL_ENABLE_FLAG_OPERATORS macro. Every operation is carried out on the
+/// unsigned underlying type, so the result always fits back into the enumeration.
+template <typename EnumType> using flag_bits_t = std::make_unsigned_t<std::underlying_type_t<EnumType>>;
+
+template <typename EnumType> [[nodiscard]] constexpr auto flag_or(EnumType lhs, EnumType rhs) noexcept -> EnumType
+{
+    using bits_t = flag_bits_t<EnumType>;
+    return static_cast<EnumType>(static_cast<bits_t>(static_cast<bits_t>(lhs) | static_cast<bits_t>(rhs)));
+}
+
+template <typename EnumType> [[nodiscard]] constexpr auto flag_and(EnumType lhs, EnumType rhs) noexcept -> EnumType
+{
+    using bits_t = flag_bits_t<EnumType>;
+    return static_cast<EnumType>(static_cast<bits_t>(static_cast<bits_t>(lhs) & static_cast<bits_t>(rhs)));
+}
+
+template <typename EnumType> [[nodiscard]] constexpr auto flag_xor(EnumType lhs, EnumType rhs) noexcept -> EnumType
+{
+    using bits_t = flag_bits_t<EnumType>;
+    return static_cast<EnumType>(static_cast<bits_t>(static_cast<bits_t>(lhs) ^ static_cast<bits_t>(rhs)));
+}
+
+template <typename EnumType> [[nodiscard]] constexpr auto flag_not(EnumType value) noexcept -> EnumType
+{
+    using bits_t = flag_bits_t<EnumType>;
+    return static_cast<EnumType>(static_cast<bits_t>(~static_cast<bits_t>(value)));
+}
+
+/// @brief Uses-allocator construction, what C++20 calls std::make_obj_using_allocator.
+///
+/// @details Builds a `T` from `args`, handing it `allocator` when `T` says it uses one, either as the
+/// leading (std::allocator_arg, allocator) pair or as the trailing argument.
+template <typename T, typename Allocator, typename... Args>
+[[nodiscard]] auto make_using_allocator(Allocator const &allocator, Args &&...args) -> T
+{
+    if constexpr (!std::uses_allocator_v<T, Allocator>)
+    {
+        return T(std::forward<Args>(args)...);
+    }
+    else if constexpr (std::is_constructible_v<T, std::allocator_arg_t, Allocator const &, Args...>)
+    {
+        return T(std::allocator_arg, allocator, std::forward<Args>(args)...);
+    }
+    else
+    {
+        return T(std::forward<Args>(args)..., allocator);
+    }
+}
+
+} // namespace internal
+
 /// @brief Ditch those old C style for loops and iterate over your enums safely with ranged for loops.
 ///
-/// @details Currently assumes the enumeration is contiguous (no gaps).
+/// @details Currently assumes the enumeration is contiguous (no gaps). The iterator models a random access
+/// iterator, so a range can be handed straight to the STL algorithms, including the parallel overloads such as
+/// `std::for_each(std::execution::par, iter.begin(), iter.end(), func)` to fan work out per enumerator.
 ///
 /// @example tests/enum_iterable_test.cpp
 template <typename EnumIterable, EnumIterable beginValue, EnumIterable endValue> class EnumerationIterator
@@ -83,27 +333,109 @@ template <typename EnumIterable, EnumIterable beginValue, EnumIterable endValue>
     EnumerationIterator(EnumerationIterator const &other) = default;
     auto operator=(EnumerationIterator const &other) -> EnumerationIterator & = default;
 
+  public:
+    /// @brief Iterator traits, the iterator is random access so STL algorithms such as std::distance
+    /// and std::lower_bound take their constant time paths, and parallel algorithms can split the range.
+    ///
+    /// @details Dereferencing yields the enumerator by value, as there is no underlying storage to refer to.
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = EnumIterable;
+    using difference_type = std::ptrdiff_t;
+    using pointer = EnumIterable const *;
+    using reference = EnumIterable;
+
   public:
     /// @brief ++this overload
     ///
     /// @details Increments the underlying value and then returns
-    /// an instance of itself. this++ not implemented, as it is
-    /// ineffecient and usually not needed.
-    [[maybe_unused]] auto operator++() noexcept -> EnumerationIterator
+    /// a reference to itself.
+    [[maybe_unused]] auto operator++() noexcept -> EnumerationIterator &
+    {
+        ++this->_value;
+        return *this;
+    }
+
+    /// @brief this++ overload
+    ///
+    /// @details Prefer ++this, this overload exists to satisfy the iterator requirements
+    /// of the standard algorithms.
+    [[maybe_unused]] auto operator++(int) noexcept -> EnumerationIterator
     {
+        auto previous = *this;
         ++this->_value;
+        return previous;
+    }
+
+    /// @brief --this overload
+    [[maybe_unused]] auto operator--() noexcept -> EnumerationIterator &
+    {
+        --this->_value;
+        return *this;
+    }
+
+    /// @brief this-- overload
+    [[maybe_unused]] auto operator--(int) noexcept -> EnumerationIterator
+    {
+        auto previous = *this;
+        --this->_value;
+        return previous;
+    }
+
+    /// @brief Compound assignment arithmetic overloads, move the iterator `offset` enumerators at once.
+    auto operator+=(difference_type offset) noexcept -> EnumerationIterator &
+    {
+        _value += offset;
+        return *this;
+    }
+
+    auto operator-=(difference_type offset) noexcept -> EnumerationIterator &
+    {
+        _value -= offset;
         return *this;
     }
 
+    /// @brief Arithmetic overloads
+    [[nodiscard]] auto operator+(difference_type offset) const noexcept -> EnumerationIterator
+    {
+        auto iter = *this;
+        iter += offset;
+        return iter;
+    }
+
+    [[nodiscard]] friend auto operator+(difference_type offset, EnumerationIterator const &iter) noexcept
+        -> EnumerationIterator
+    {
+        return iter + offset;
+    }
+
+    [[nodiscard]] auto operator-(difference_type offset) const noexcept -> EnumerationIterator
+    {
+        auto iter = *this;
+        iter -= offset;
+        return iter;
+    }
+
+    /// @brief The distance between two iterators in constant time.
+    [[nodiscard]] auto operator-(EnumerationIterator const &other_iterator) const noexcept -> difference_type
+    {
+        return _value - other_iterator._value;
+    }
+
     /// @brief Dereference overload
     ///
     /// @details Gets an instance to the current underlying value
     /// after casting it the type EnumIterable.
-    [[nodiscard]] auto operator*() noexcept -> EnumIterable
+    [[nodiscard]] auto operator*() const noexcept -> EnumIterable
     {
         return static_cast<EnumIterable>(_value);
     }
 
+    /// @brief Subscript overload, gets the enumerator `offset` places away from the current one.
+    [[nodiscard]] auto operator[](difference_type offset) const noexcept -> EnumIterable
+    {
+        return static_cast<EnumIterable>(_value + offset);
+    }
+
     /// @brief Is equal overload
     [[nodiscard]] auto operator==(EnumerationIterator const &other_iterator) const noexcept -> bool
     {
@@ -116,6 +448,27 @@ template <typename EnumIterable, EnumIterable beginValue, EnumIterable endValue>
         return !(*this == other_iterator);
     }
 
+    /// @brief Ordering overloads
+    [[nodiscard]] auto operator<(EnumerationIterator const &other_iterator) const noexcept -> bool
+    {
+        return _value < other_iterator._value;
+    }
+
+    [[nodiscard]] auto operator<=(EnumerationIterator const &other_iterator) const noexcept -> bool
+    {
+        return _value <= other_iterator._value;
+    }
+
+    [[nodiscard]] auto operator>(EnumerationIterator const &other_iterator) const noexcept -> bool
+    {
+        return _value > other_iterator._value;
+    }
+
+    [[nodiscard]] auto operator>=(EnumerationIterator const &other_iterator) const noexcept -> bool
+    {
+        return _value >= other_iterator._value;
+    }
+
   public:
     /// @brief Return the beginning value, this will use the default constructor.
     [[nodiscard]] auto begin() const noexcept -> EnumerationIterator
@@ -123,15 +476,210 @@ template <typename EnumIterable, EnumIterable beginValue, EnumIterable endValue>
         return *this;
     }
 
-    /// @brief Return the end value.
-    [[nodiscard]] auto end() noexcept -> EnumerationIterator
+    /// @brief Return the end value, one past the last enumerator.
+    [[nodiscard]] auto end() const noexcept -> EnumerationIterator
+    {
+        return ++EnumerationIterator(endValue);
+    }
+
+    /// @brief The number of enumerators in the range [beginValue, endValue].
+    [[nodiscard]] static constexpr auto size() noexcept -> std::size_t
+    {
+        return internal::enum_offset(endValue, beginValue) + 1;
+    }
+};
+
+/// @brief A fixed size array indexed by the enumerators of a contiguous enumeration.
+///
+/// @details Holds one ValueType per enumerator in [beginValue, endValue], stored contiguously in
+/// enumeration order. Lookups by enumerator are a subtraction and an array index.
+///
+/// @example tests/enum_iterable_test.cpp
+template <typename EnumType, EnumType beginValue, EnumType endValue, typename ValueType> class EnumArray
+{
+  private:
+    using EnumIterator = EnumerationIterator<EnumType, beginValue, endValue>;
+    std::array<ValueType, EnumIterator::size()> _values{};
+
+  public:
+    using value_type = ValueType;
+    using iterator = typename std::array<ValueType, EnumIterator::size()>::iterator;
+    using const_iterator = typename std::array<ValueType, EnumIterator::size()>::const_iterator;
+
+  public:
+    /// @brief Access the value stored for an enumerator, the enumerator must be within the range.
+    [[nodiscard]] constexpr auto operator[](EnumType key) noexcept -> ValueType &
+    {
+        return _values[internal::enum_offset(key, beginValue)];
+    }
+
+    [[nodiscard]] constexpr auto operator[](EnumType key) const noexcept -> ValueType const &
+    {
+        return _values[internal::enum_offset(key, beginValue)];
+    }
+
+    /// @brief The number of enumerators, and therefore values, in the array.
+    [[nodiscard]] static constexpr auto size() noexcept -> std::size_t
+    {
+        return EnumIterator::size();
+    }
+
+    /// @brief Iterate over the values in enumeration order.
+    [[nodiscard]] constexpr auto begin() noexcept -> iterator
+    {
+        return _values.begin();
+    }
+
+    [[nodiscard]] constexpr auto begin() const noexcept -> const_iterator
+    {
+        return _values.begin();
+    }
+
+    [[nodiscard]] constexpr auto end() noexcept -> iterator
+    {
+        return _values.end();
+    }
+
+    [[nodiscard]] constexpr auto end() const noexcept -> const_iterator
+    {
+        return _values.end();
+    }
+};
+
+/// @brief Runs `func(enumerator)` for every enumerator in [beginValue, endValue] across a pool of threads.
+///
+/// @details Each enumerator is handed to the next free thread, and whatever `func` returns, typically a
+/// Result<T, Error>, is stored in the slot of its enumerator. Every enumerator is always processed, a failure in
+/// one shard does not stop the others, so the returned array holds the aggregate of all successes and errors.
+/// `func` is called concurrently and should report failures through its return value. If it throws anyway, the
+/// remaining enumerators are skipped, all threads are joined and the first exception is rethrown to the caller.
+///
+/// @param `func` invocable taking the enumerator and returning a default constructible type.
+/// @param `max_threads` upper bound on the number of threads to use, zero uses one per hardware thread.
+///
+/// @example tests/enum_iterable_test.cpp
+template <typename EnumType, EnumType beginValue, EnumType endValue, typename Function>
+[[nodiscard]] auto parallel_for_each_enum(Function &&func, std::size_t max_threads = 0)
+    -> EnumArray<EnumType, beginValue, endValue, std::invoke_result_t<Function &, EnumType>>
+{
+    using EnumIterator = EnumerationIterator<EnumType, beginValue, endValue>;
+
+    EnumArray<EnumType, beginValue, endValue, std::invoke_result_t<Function &, EnumType>> results;
+    const EnumIterator range;
+    internal::parallel_for_index(EnumIterator::size(), max_threads, [&](std::size_t index) {
+        const auto key = range[static_cast<typename EnumIterator::difference_type>(index)];
+        results[key] = std::invoke(func, key);
+    });
+    return results;
+}
+
+/// @brief Iterate over the set bits of a bit flag enumeration with ranged for loops.
+///
+/// @details EnumerationIterator steps through every integer between two enumerators, which does not work for
+/// enumerations such as `enum class Flags { A = 1, B = 2, C = 4 }`. This iterator only visits the flags which are
+/// set in the value it is constructed with, in ascending order. Dereferencing isolates the lowest set bit and
+/// incrementing clears it (the blsi/blsr pair on x86), so a walk costs one step per set flag rather than one per bit.
+///
+/// @example tests/enum_iterable_test.cpp
+template <typename EnumType> class EnumerationFlagIterator
+{
+  private:
+    using bits_t = internal::flag_bits_t<EnumType>;
+    bits_t _bits;
+
+  public:
+    /// @brief Constructs an instance which visits every flag set in `flags`.
+    constexpr explicit EnumerationFlagIterator(EnumType flags) noexcept : _bits(static_cast<bits_t>(flags))
+    {
+    }
+
+  public:
+    /// @brief ++this overload, clears the lowest set flag.
+    constexpr auto operator++() noexcept -> EnumerationFlagIterator &
+    {
+        _bits = static_cast<bits_t>(_bits & (_bits - 1U));
+        return *this;
+    }
+
+    /// @brief Dereference overload, gets the lowest set flag.
+    [[nodiscard]] constexpr auto operator*() const noexcept -> EnumType
+    {
+        return static_cast<EnumType>(static_cast<bits_t>(_bits & (0U - _bits)));
+    }
+
+    /// @brief Is equal overload
+    [[nodiscard]] constexpr auto operator==(EnumerationFlagIterator const &other_iterator) const noexcept -> bool
+    {
+        return _bits == other_iterator._bits;
+    }
+
+    /// @brief Not equal overload
+    [[nodiscard]] constexpr auto operator!=(EnumerationFlagIterator const &other_iterator) const noexcept -> bool
+    {
+        return !(*this == other_iterator);
+    }
+
+  public:
+    /// @brief Return the beginning value, the flags this instance was constructed with.
+    [[nodiscard]] constexpr auto begin() const noexcept -> EnumerationFlagIterator
+    {
+        return *this;
+    }
+
+    /// @brief Return the end value, reached once every flag has been cleared.
+    [[nodiscard]] constexpr auto end() const noexcept -> EnumerationFlagIterator
+    {
+        return EnumerationFlagIterator(static_cast<EnumType>(0));
+    }
+
+    /// @brief How many flags are left to visit.
+    [[nodiscard]] constexpr auto size() const noexcept -> std::size_t
     {
-        // cache the value
-        static const auto endIter = ++EnumerationIterator(endValue);
-        return endIter;
+        return internal::popcount(static_cast<std::uint64_t>(_bits));
     }
 };
 
+/// @brief Check if every flag in `flags` is set in `value`.
+template <typename EnumType> [[nodiscard]] constexpr auto has_flags(EnumType value, EnumType flags) noexcept -> bool
+{
+    return internal::flag_and(value, flags) == flags;
+}
+
+/// @brief Defines type safe `|`, `&`, `^`, `~` and their compound assignment operators for a bit flag enumeration.
+///
+/// @details Must be invoked in the same namespace as the enumeration so the operators are found by argument
+/// dependent lookup. Note that `~` flips every bit of the underlying type, mask the result with the flags you
+/// care about before iterating it with EnumerationFlagIterator.
+#define ETL_ENABLE_FLAG_OPERATORS(EnumType)                                                                            \
+    [[nodiscard]] constexpr auto operator|(EnumType lhs, EnumType rhs) noexcept -> EnumType                            \
+    {                                                                                                                  \
+        return ::etl::internal::flag_or(lhs, rhs);                                                                     \
+    }                                                                                                                  \
+    [[nodiscard]] constexpr auto operator&(EnumType lhs, EnumType rhs) noexcept -> EnumType                            \
+    {                                                                                                                  \
+        return ::etl::internal::flag_and(lhs, rhs);                                                                    \
+    }                                                                                                                  \
+    [[nodiscard]] constexpr auto operator^(EnumType lhs, EnumType rhs) noexcept -> EnumType                            \
+    {                                                                                                                  \
+        return ::etl::internal::flag_xor(lhs, rhs);                                                                    \
+    }                                                                                                                  \
+    [[nodiscard]] constexpr auto operator~(EnumType value) noexcept -> EnumType                                        \
+    {                                                                                                                  \
+        return ::etl::internal::flag_not(value);                                                                       \
+    }                                                                                                                  \
+    constexpr auto operator|=(EnumType &lhs, EnumType rhs) noexcept -> EnumType &                                      \
+    {                                                                                                                  \
+        return lhs = ::etl::internal::flag_or(lhs, rhs);                                                               \
+    }                                                                                                                  \
+    constexpr auto operator&=(EnumType &lhs, EnumType rhs) noexcept -> EnumType &                                      \
+    {                                                                                                                  \
+        return lhs = ::etl::internal::flag_and(lhs, rhs);                                                              \
+    }                                                                                                                  \
+    constexpr auto operator^=(EnumType &lhs, EnumType rhs) noexcept -> EnumType &                                      \
+    {                                                                                                                  \
+        return lhs = ::etl::internal::flag_xor(lhs, rhs);                                                              \
+    }
+
 /// @brief Tag a primitive fundamental type to descriptive class names.
 ///
 /// @details Solves the issue when a function takes in many arguments of the same type,
@@ -444,32 +992,202 @@ template <typename Tag, typename FundamentalType> class TaggedFundamental
     }
 };
 
-/// @brief Holds useful runtime source code location information for use in Errors.
+namespace internal
+{
+/// @brief The line size assumed when padding data that different threads write to.
+constexpr std::size_t cache_line_size = 64;
+} // namespace internal
+
+/// @brief Define ETL_ERROR_SITE_COUNTERS before including etl.hpp, in every translation unit, to have every
+/// RUNTIME_INFO call site count the errors created there. Each expansion then owns a function local static
+/// ErrorSite of a few hundred bytes, every SourceCodeLocation carries a pointer to it, and RUNTIME_INFO
+/// expands to a lambda, so under C++17 it can no longer appear in unevaluated operands such as decltype.
+/// Sites are linked into a global list that is never unlinked from, so a library that creates errors this way
+/// must not be unloaded with dlclose() while error_site_counts() may still be called.
+#if defined(ETL_ERROR_SITE_COUNTERS)
+namespace internal
+{
+/// @brief Counters are spread over this many shards, each on its own cache line, so threads
+/// creating errors at the same call site don't fight over one line.
+constexpr std::size_t error_site_shards = 8;
+
+/// @brief The shard this thread counts into, threads are dealt shards round robin as they first ask.
+inline auto error_site_shard() noexcept -> std::size_t
+{
+    static std::atomic<std::size_t> next_shard{0};
+    thread_local const std::size_t shard = next_shard.fetch_add(1, std::memory_order_relaxed) % error_site_shards;
+    return shard;
+}
+} // namespace internal
+
+/// @brief How many errors one call site has created, as returned by error_site_counts().
+class ErrorSiteCount
+{
+  public:
+    std::string_view file;
+    uint32_t line{0};
+    std::string_view function;
+    uint64_t count{0};
+};
+
+/// @brief A static descriptor of one RUNTIME_INFO call site, and the number of errors created there.
 ///
-/// @details Should not be used directly, rather the user should pass the `etl::RUNTIME_INFO`
-/// macro invocation.
-class SourceCodeLocation
+/// @details RUNTIME_INFO creates one of these, as a function local static, the first time its line runs.
+/// Construction links it into a lock-free global list, after that counting an error is one relaxed
+/// atomic add on this thread's shard. There is no reason to create one by hand.
+class ErrorSite
 {
   private:
-    std::string _file;
-    uint32_t _line;
-    std::string _func;
+    /// @brief One shard of the counter, padded to a cache line.
+    class alignas(internal::cache_line_size) Shard
+    {
+      public:
+        std::atomic<uint64_t> count{0};
+    };
 
-  public:
-    SourceCodeLocation() = delete;
+    std::string_view _file;
+    uint32_t _line;
+    std::string_view _func;
+    std::array<Shard, internal::error_site_shards> _shards{};
+    ErrorSite *_next{nullptr};
 
-    /// @brief The only valid constructor
-    ///
-    /// @param `file` name of the file where the error occurred
-    /// @param `line` line number where the error occurred
-    /// @param `func` name of the function where the error occurred
-    SourceCodeLocation(std::string_view const &file, uint32_t line, std::string_view const &func) noexcept
-        : _file(file), _line(line), _func(func)
+    /// @brief The most recently registered site, the list is only ever pushed to.
+    static auto head() noexcept -> std::atomic<ErrorSite *> &
     {
+        static std::atomic<ErrorSite *> sites{nullptr};
+        return sites;
     }
 
-    /// @brief Default Destructor, Move/Copy constructor and assignment
-    virtual ~SourceCodeLocation() = default;
+  public:
+    ErrorSite(std::string_view const &file, uint32_t line, std::string_view const &func) noexcept
+        : _file(file), _line(line), _func(func), _next(head().load(std::memory_order_relaxed))
+    {
+        while (!head().compare_exchange_weak(_next, this, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    /// @brief Sites are registered by address and never unregistered, they must not move or go away.
+    ~ErrorSite() = default;
+    ErrorSite(ErrorSite &&other) noexcept = delete;
+    auto operator=(ErrorSite &&other) noexcept -> ErrorSite & = delete;
+    ErrorSite(ErrorSite const &other) = delete;
+    auto operator=(ErrorSite const &other) -> ErrorSite & = delete;
+
+  public:
+    [[nodiscard]] inline auto file() const noexcept -> std::string_view
+    {
+        return _file;
+    }
+
+    [[nodiscard]] inline auto line() const noexcept -> uint32_t
+    {
+        return _line;
+    }
+
+    [[nodiscard]] inline auto function() const noexcept -> std::string_view
+    {
+        return _func;
+    }
+
+    /// @brief Counts one error created at this site.
+    inline auto record() noexcept -> void
+    {
+        _shards[internal::error_site_shard()].count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// @brief Sums the shards, racing increments may or may not be included.
+    [[nodiscard]] inline auto count() const noexcept -> uint64_t
+    {
+        uint64_t total = 0;
+        for (auto const &shard : _shards)
+        {
+            total += shard.count.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    /// @brief Calls `func` with every site registered so far, most recently registered first.
+    template <typename Function> static auto for_each(Function &&func) -> void
+    {
+        for (auto const *site = head().load(std::memory_order_acquire); site != nullptr; site = site->_next)
+        {
+            std::invoke(func, *site);
+        }
+    }
+};
+
+/// @brief A snapshot of how many errors every RUNTIME_INFO call site that has run has created.
+///
+/// @details Safe to call from any thread at any time, meant to be polled and exported as metrics.
+[[nodiscard]] inline auto error_site_counts() -> std::vector<ErrorSiteCount>
+{
+    std::vector<ErrorSiteCount> counts;
+    ErrorSite::for_each([&counts](ErrorSite const &site) {
+        counts.push_back(ErrorSiteCount{site.file(), site.line(), site.function(), site.count()});
+    });
+    return counts;
+}
+#endif
+
+/// @brief Tag selecting the SourceCodeLocation constructor that views strings which are not literals.
+///
+/// @details Passing it is the caller's promise that the strings outlive the location and every copy of it,
+/// Errors included, which may be read on other threads, by an ErrorSink for instance, long after the call.
+class BorrowedStrings
+{
+};
+
+inline constexpr BorrowedStrings borrowed_strings{};
+
+/// @brief Holds useful runtime source code location information for use in Errors.
+///
+/// @details Should not be used directly, rather the user should pass the `etl::RUNTIME_INFO`
+/// macro invocation. A location only views its file and function names, it never copies them, so building
+/// one costs nothing. That is only safe when the names outlive it, so the plain constructor accepts string
+/// literals alone, anything else has to be passed with `etl::borrowed_strings`.
+class SourceCodeLocation
+{
+  private:
+    std::string_view _file;
+    uint32_t _line;
+    std::string_view _func;
+#if defined(ETL_ERROR_SITE_COUNTERS)
+    ErrorSite *_site{nullptr};
+#endif
+
+  public:
+    SourceCodeLocation() = delete;
+
+    /// @brief Builds a location by hand from string literals, errors created with it are not counted.
+    ///
+    /// @param `file` name of the file where the error occurred
+    /// @param `line` line number where the error occurred
+    /// @param `func` name of the function where the error occurred
+    template <std::size_t FileSize, std::size_t FuncSize>
+    SourceCodeLocation(const char (&file)[FileSize], uint32_t line, const char (&func)[FuncSize]) noexcept
+        : _file(file), _line(line), _func(func)
+    {
+    }
+
+    /// @brief Builds a location over strings the caller keeps alive for as long as the location or any copy
+    /// of it, see BorrowedStrings.
+    SourceCodeLocation(BorrowedStrings /*unused*/, std::string_view const &file, uint32_t line,
+                       std::string_view const &func) noexcept
+        : _file(file), _line(line), _func(func)
+    {
+    }
+
+#if defined(ETL_ERROR_SITE_COUNTERS)
+    /// @brief The constructor RUNTIME_INFO uses, errors created with the location are counted against `site`.
+    explicit SourceCodeLocation(ErrorSite &site) noexcept
+        : _file(site.file()), _line(site.line()), _func(site.function()), _site(&site)
+    {
+    }
+#endif
+
+    /// @brief Default Destructor, Move/Copy constructor and assignment
+    virtual ~SourceCodeLocation() = default;
     SourceCodeLocation(SourceCodeLocation &&other) noexcept = default;
     auto operator=(SourceCodeLocation &&other) noexcept -> SourceCodeLocation & = default;
     SourceCodeLocation(SourceCodeLocation const &other) = default;
@@ -493,15 +1211,39 @@ class SourceCodeLocation
     {
         return _func;
     }
+
+#if defined(ETL_ERROR_SITE_COUNTERS)
+    /// @brief Get the call site counter, null unless the location came from RUNTIME_INFO
+    [[nodiscard]] inline auto site() const noexcept -> ErrorSite *
+    {
+        return _site;
+    }
+#endif
 };
 
 /// @brief Wrapper macro which constructs an instance of SourceCodeLocation in-place
 /// and guarantees that the accurate file, function name, and line number will be
 /// reported.
+///
+/// @details With ETL_ERROR_SITE_COUNTERS every expansion owns a function local static ErrorSite, registered
+/// the first time it runs, which counts the errors created there. The function name is passed into the lambda
+/// since inside it __PRETTY_FUNCTION__ would name the lambda.
+#if defined(ETL_ERROR_SITE_COUNTERS)
+#define ETL_ERROR_SITE(func)                                                                                           \
+    [](std::string_view const &etl_site_function) -> ::etl::ErrorSite & {                                              \
+        static ::etl::ErrorSite etl_error_site(__FILE__, __LINE__, etl_site_function);                                 \
+        return etl_error_site;                                                                                         \
+    }(func)
+
 #ifdef __linux__
-#define RUNTIME_INFO SourceCodeLocation(__FILE__, __LINE__, static_cast<const char *>(__PRETTY_FUNCTION__))
+#define RUNTIME_INFO ::etl::SourceCodeLocation(ETL_ERROR_SITE(static_cast<const char *>(__PRETTY_FUNCTION__)))
+#else
+#define RUNTIME_INFO ::etl::SourceCodeLocation(ETL_ERROR_SITE(static_cast<const char *>(__func__)))
+#endif
+#elif defined(__linux__)
+#define RUNTIME_INFO ::etl::SourceCodeLocation(__FILE__, __LINE__, __PRETTY_FUNCTION__)
 #else
-#define RUNTIME_INFO SourceCodeLocation(__FILE__, __LINE__, static_cast<const char *>(__func__))
+#define RUNTIME_INFO ::etl::SourceCodeLocation(__FILE__, __LINE__, __func__)
 #endif
 
 /// @brief Interface for an Error class
@@ -520,304 +1262,3901 @@ class IError
     [[nodiscard]] virtual inline auto info() const noexcept -> std::string = 0;
 };
 
-/// @brief A basic Error object which can be built using an error message and the
-/// SourceCodeLocation RUNTIME_INFO macro.
-class Error : public IError
+namespace internal
 {
-  private:
-    std::string _msg;
-    std::string _info;
+/// @brief The resource installed by the innermost pmr::ErrorResourceScope on this thread, if any.
+inline auto thread_error_resource() noexcept -> std::pmr::memory_resource *&
+{
+    thread_local std::pmr::memory_resource *resource = nullptr;
+    return resource;
+}
 
+#if defined(ETL_ERROR_BACKTRACE)
+/// @brief The raw return addresses of the call stack an error was created on.
+///
+/// @details Capturing is a single backtrace() call into a fixed array, turning the addresses into
+/// symbol names is the expensive part, and is left to append_backtrace(), which only info() calls.
+class ErrorBacktrace
+{
   private:
-    /// @brief Constructs the error with only a message
-    ///
-    /// @details This constructor is private to prevent the user from circumventing the create() method
-    explicit Error(std::string_view const &msg) noexcept : _msg(msg)
-    {
-    }
+    std::array<void *, ETL_ERROR_BACKTRACE_DEPTH> _frames{};
+    int _depth{0};
 
-    /// @brief Constructs the error with the message and source location
-    /// using move semantics
-    ///
-    /// @details This constructor is private to prevent the user from circumventing the create() method
-    ///
-    /// @param `msg` the error message
-    /// @param `slc` the source code location object
-    Error(std::string_view const &msg, SourceCodeLocation const &slc) noexcept : _msg(msg)
+  protected:
+    auto capture_backtrace() noexcept -> void
     {
-        _info.append("Error: ")
-            .append(msg)
-            .append("\nFunction: ")
-            .append(slc.function())
-            .append("\nFile: ")
-            .append(slc.file())
-            .append(":")
-            .append(std::to_string(slc.line()));
+        _depth = ::backtrace(_frames.data(), static_cast<int>(_frames.size()));
     }
 
-  public:
-    /// @brief Default Destructor, Move/Copy constructor and assignment
-    ~Error() override = default;
-    Error(Error &&other) noexcept = default;
-    auto operator=(Error &&other) noexcept -> Error & = default;
-    Error(Error const &other) = default;
-    auto operator=(Error const &other) -> Error & = default;
-
-  public:
-    /// @brief Creates an Error object with only an error message via string_view
-    [[nodiscard]] inline static auto create(std::string_view const &msg) -> Error
+    auto append_backtrace(std::string &info) const -> void
     {
-        auto error = Error(msg);
-        return error;
+        if (_depth <= 0)
+        {
+            return;
+        }
+        char **symbols = ::backtrace_symbols(_frames.data(), _depth);
+        info.append("\nBacktrace:");
+        for (int frame = 0; frame < _depth; ++frame)
+        {
+            info.append("\n  #").append(std::to_string(frame)).append(" ");
+            if (symbols != nullptr)
+            {
+                info.append(symbols[frame]);
+            }
+            else
+            {
+                constexpr std::string_view digits = "0123456789abcdef";
+                auto address = reinterpret_cast<std::uintptr_t>(_frames[static_cast<std::size_t>(frame)]);
+                std::string hex;
+                do
+                {
+                    hex.insert(hex.begin(), digits[address & 0xFU]);
+                    address >>= 4U;
+                } while (address != 0);
+                info.append("0x").append(hex);
+            }
+        }
+        std::free(symbols);
     }
 
-    /// @brief Creates an Error object with error message and source location information
-    /// using move semantics
-    [[nodiscard]] inline static auto create(std::string_view const &msg, SourceCodeLocation const &slc) -> Error
+  public:
+    /// @brief Get how many return addresses were captured
+    [[nodiscard]] auto backtrace_depth() const noexcept -> std::size_t
     {
-        auto error = Error(msg, slc);
-        return error;
+        return static_cast<std::size_t>(_depth);
     }
-
-  public:
-    /// @brief Get just the error message
-    [[nodiscard]] inline auto msg() const noexcept -> std::string override
+};
+#else
+/// @brief Backtraces are compiled out, an empty base which costs neither space nor time.
+class ErrorBacktrace
+{
+  protected:
+    auto capture_backtrace() noexcept -> void
     {
-        return _msg;
     }
 
-    /// @brief Override the current error message, useful when using the Result.mapErr method.
-    [[nodiscard]] inline auto set(std::string_view const &msg) noexcept
+    auto append_backtrace(std::string & /*info*/) const -> void
     {
-        _msg = msg;
     }
 
-    /// @brief Get the pre-formatted (pretty printed) error string.
-    ///
-    /// @details  If Error was not created with the RUNTIME_INFO macro info_ will be empty,
-    /// in which case the msg_ will be returned instead.
-    [[nodiscard]] inline auto info() const noexcept -> std::string override
+  public:
+    /// @brief Always zero, define ETL_ERROR_BACKTRACE to capture backtraces
+    [[nodiscard]] auto backtrace_depth() const noexcept -> std::size_t
     {
-        if (!_info.empty())
-        {
-            return _info;
-        }
-        return _msg;
+        return 0;
     }
 };
+#endif
+} // namespace internal
 
-/// @brief Empty stub type for when the user wants a result with an Ok type
-/// with no value, since c++ doesn't have rusts () type, this is my workaround.
+namespace pmr
+{
+
+/// @brief The memory resource pmr errors created on this thread allocate from.
 ///
-/// @details In Rust it would be Result<(), String>.
-/// Converted into this C++ class would be, Result<Void, std::string>.
-class Void
+/// @details The resource of the innermost ErrorResourceScope on this thread, or the process wide
+/// std::pmr::get_default_resource() outside of any scope.
+[[nodiscard]] inline auto error_resource() noexcept -> std::pmr::memory_resource *
 {
-};
+    auto *resource = internal::thread_error_resource();
+    return resource != nullptr ? resource : std::pmr::get_default_resource();
+}
 
-/// @brief Generic Result type modeled after the Rust lanaguage's Result<T, E>
-template <typename OkType, typename ErrType> class Result
+/// @brief Routes every etl::pmr::Error created on this thread, while the scope is alive, to `resource`.
+///
+/// @details Meant to wrap one request: hand it a std::pmr::monotonic_buffer_resource and all the errors
+/// created while handling the request are carved out of that buffer, then released in one shot with it.
+/// Errors must not outlive the resource they were allocated from. Scopes nest, and restore the previous
+/// resource when they end.
+class ErrorResourceScope
 {
   private:
-    std::variant<OkType, ErrType> _result;
-    bool _is_ok{false};
+    std::pmr::memory_resource *_previous;
 
   public:
-    /// @brief All the constructors needed to build an OkType or ErrType
-    Result() noexcept = default;
-    explicit Result(OkType const &value) noexcept : _result(value), _is_ok(true)
+    explicit ErrorResourceScope(std::pmr::memory_resource *resource) noexcept
+        : _previous(std::exchange(internal::thread_error_resource(), resource))
     {
     }
-    explicit Result(OkType &&value) noexcept : _result(std::move(value)), _is_ok(true)
+
+    ~ErrorResourceScope()
     {
+        internal::thread_error_resource() = _previous;
     }
-    explicit Result(ErrType const &error) noexcept : _result(error)
+
+    ErrorResourceScope(ErrorResourceScope &&other) noexcept = delete;
+    auto operator=(ErrorResourceScope &&other) noexcept -> ErrorResourceScope & = delete;
+    ErrorResourceScope(ErrorResourceScope const &other) = delete;
+    auto operator=(ErrorResourceScope const &other) -> ErrorResourceScope & = delete;
+};
+
+} // namespace pmr
+
+namespace internal
+{
+/// @brief The allocator an error uses when none is passed to create().
+template <typename Allocator> struct DefaultErrorAllocator
+{
+    [[nodiscard]] static auto get() noexcept -> Allocator
     {
+        return Allocator();
     }
-    explicit Result(ErrType &&error) noexcept : _result(std::move(error))
+};
+
+/// @brief Formats a source location on its own lines below an error, nothing when there is none.
+inline auto append_location(std::string &info, std::optional<SourceCodeLocation> const &slc,
+                            std::string_view const &indent) -> void
+{
+    if (!slc.has_value())
     {
+        return;
     }
+    info.append("\n")
+        .append(indent)
+        .append("Function: ")
+        .append(slc->function())
+        .append("\n")
+        .append(indent)
+        .append("File: ")
+        .append(slc->file())
+        .append(":")
+        .append(std::to_string(slc->line()));
+}
 
-    /// @brief Default Destructor, Move/Copy constructor and assignment
-    virtual ~Result() = default;
-    Result(Result &&other) noexcept = default;
-    auto operator=(Result &&other) noexcept -> Result & = default;
-    Result(const Result &other) = default;
-    auto operator=(const Result &other) -> Result & = default;
+/// @brief Polymorphic allocators follow the ErrorResourceScope of the calling thread.
+template <> struct DefaultErrorAllocator<std::pmr::polymorphic_allocator<char>>
+{
+    [[nodiscard]] static auto get() noexcept -> std::pmr::polymorphic_allocator<char>
+    {
+        return std::pmr::polymorphic_allocator<char>(pmr::error_resource());
+    }
+};
+} // namespace internal
 
+/// @brief A basic Error object which can be built using an error message and the
+/// SourceCodeLocation RUNTIME_INFO macro.
+///
+/// @details The message is stored in a string using `Allocator`. Use etl::Error for the default heap
+/// allocation, or etl::pmr::Error to carve the message out of a std::pmr::memory_resource, either passed
+/// to create() or installed for the calling thread by an etl::pmr::ErrorResourceScope. A copy constructed
+/// error allocates from the same allocator as the original. Assignment behaves like the standard containers,
+/// the target keeps its own allocator unless `propagate_on_container_copy_assignment` (or `_move_assignment`)
+/// of `Allocator` says to take the source's, so a pmr error assigned to another stays in its own arena.
+///
+/// As an error travels up through the layers of a program each of them can attach context() to it, the
+/// original message is kept. An error without context holds no more than its message and location, the
+/// frames live in a block allocated with `Allocator` the first time context() is called. The block holds the
+/// first `block_context_frames` frames and `block_context_text` bytes of their text, so attaching a few
+/// frames costs that one allocation, and nothing is formatted until info() is called.
+///
+/// When ETL_ERROR_BACKTRACE is defined every error also captures the call stack it was created on, which
+/// info() symbolizes and prints.
+template <typename Allocator> class BasicError : public IError, public internal::ErrorBacktrace
+{
   public:
-    /// @brief Check if the variant is of the [OkType]
-    [[nodiscard]] inline auto is_ok() const noexcept -> bool
+    using allocator_type = Allocator;
+    using string_type = std::basic_string<char, std::char_traits<char>, Allocator>;
+
+    /// @brief How many context frames, and how many bytes of their text, fit in the lazily allocated
+    /// context block before they spill to further allocations.
+    static constexpr std::size_t block_context_frames = 2;
+    static constexpr std::size_t block_context_text = 128;
+
+  private:
+    /// @brief A context frame, its message is a slice of the block's text. Offsets past
+    /// block_context_text index into the spilled text.
+    class ContextFrame
     {
-        return _is_ok;
-    }
+      public:
+        uint32_t offset{0};
+        uint32_t length{0};
+        std::optional<SourceCodeLocation> location;
+    };
 
-    /// @brief Check if the variant is of the [ErrType]
-    [[nodiscard]] inline auto is_err() const noexcept -> bool
+    using frame_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<ContextFrame>;
+
+    /// @brief Every frame attached by context(), text is appended to the block's buffer until a message
+    /// no longer fits, from then on to spilledText.
+    class ContextBlock
     {
-        return !_is_ok;
+      public:
+        std::array<ContextFrame, block_context_frames> frames{};
+        std::vector<ContextFrame, frame_allocator_type> spilledFrames;
+        std::size_t frameCount{0};
+        std::array<char, block_context_text> text{};
+        std::size_t textSize{0};
+        string_type spilledText;
+
+        explicit ContextBlock(Allocator const &allocator)
+            : spilledFrames(frame_allocator_type(allocator)), spilledText(allocator)
+        {
+        }
+
+        ContextBlock(ContextBlock const &other, Allocator const &allocator)
+            : frames(other.frames), spilledFrames(other.spilledFrames, frame_allocator_type(allocator)),
+              frameCount(other.frameCount), text(other.text), textSize(other.textSize),
+              spilledText(other.spilledText, allocator)
+        {
+        }
+    };
+
+    using block_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<ContextBlock>;
+    using block_traits = std::allocator_traits<block_allocator_type>;
+
+    string_type _msg;
+    std::optional<SourceCodeLocation> _location;
+    ContextBlock *_context{nullptr};
+
+  private:
+    /// @brief Constructs the error with only a message
+    ///
+    /// @details This constructor is private to prevent the user from circumventing the create() method
+    BasicError(std::string_view const &msg, Allocator const &allocator) : _msg(msg, allocator)
+    {
+        capture_backtrace();
     }
 
-    /// @brief Get the OkType value
+    /// @brief Constructs the error with the message and source location
     ///
-    /// @details The use should always use is_ok() before using ok()
+    /// @details This constructor is private to prevent the user from circumventing the create() method.
+    /// The location is only stored, it is formatted by info() if and when somebody asks for it. With
+    /// ETL_ERROR_SITE_COUNTERS defined, locations from RUNTIME_INFO count the error against their call site.
     ///
-    /// @return std::optinal<OkType> for safety, incase the user did not call
-    /// is_ok() before using this method.
-    [[nodiscard]] inline auto ok() const noexcept -> std::optional<OkType>
+    /// @param `msg` the error message
+    /// @param `slc` the source code location object
+    /// @param `allocator` the allocator the message is stored with
+    BasicError(std::string_view const &msg, SourceCodeLocation const &slc, Allocator const &allocator)
+        : _msg(msg, allocator), _location(slc)
     {
-        if (_is_ok)
+#if defined(ETL_ERROR_SITE_COUNTERS)
+        if (auto *site = slc.site(); site != nullptr)
         {
-            if (auto *value = std::get_if<OkType>(&_result))
-            {
-                return *value;
-            }
+            site->record();
         }
-        return std::nullopt;
+#endif
+        capture_backtrace();
     }
 
-    /// @brief Get the ErrType value
-    ///
-    /// @details The use should always use is_err() before using err()
-    ///
-    /// @return std::optinal<ErrType> for safety, incase the user did not call
-    /// is_err() before using this method.
-    [[nodiscard]] inline auto err() const noexcept -> std::optional<ErrType>
+  public:
+    /// @brief Destructor, Move/Copy constructor and assignment, the context block follows the message's allocator
+    ~BasicError() override
     {
-        if (!_is_ok)
+        destroyContext();
+    }
+
+    BasicError(BasicError &&other) noexcept
+        : IError(other), internal::ErrorBacktrace(other), _msg(std::move(other._msg)),
+          _location(std::move(other._location)), _context(std::exchange(other._context, nullptr))
+    {
+    }
+
+    auto operator=(BasicError &&other) noexcept(
+        std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+        std::allocator_traits<Allocator>::is_always_equal::value) -> BasicError &
+    {
+        if (this != &other)
         {
-            if (auto *err = std::get_if<ErrType>(&_result))
-            {
-                return *err;
-            }
+            destroyContext();
+            IError::operator=(other);
+            internal::ErrorBacktrace::operator=(other);
+            _msg = std::move(other._msg);
+            _location = std::move(other._location);
+            adoptContext(std::move(other));
         }
-        return std::nullopt;
+        return *this;
     }
 
-    /// @brief Maps a custom/lambda function to the [OkType] leaving the [ErrType] untouched.
-    ///
-    /// @details The use should always use is_ok() before using map()
-    ///
-    /// @return Returns the Result type with a modified OkType, or just the Result unmodified
-    /// if is_ok() is false.
-    template <typename Function>
-    [[nodiscard]] inline auto map(Function &&func) const noexcept -> Result<OkType, ErrType>
+    BasicError(BasicError const &other) : BasicError(std::allocator_arg, other.get_allocator(), other)
     {
-        if (_is_ok)
+    }
+
+    auto operator=(BasicError const &other) -> BasicError &
+    {
+        if (this != &other)
         {
-            if constexpr (std::is_invocable_r_v<OkType, Function, OkType const &>)
-            {
-                return Result<OkType, ErrType>(
-                    std::invoke(std::forward<Function>(func), *std::get_if<OkType>(&_result)));
-            }
-            else
-            {
-                return Result<OkType, ErrType>(*std::get_if<OkType>(&_result));
-            }
+            destroyContext();
+            IError::operator=(other);
+            internal::ErrorBacktrace::operator=(other);
+            _msg = other._msg;
+            _location = other._location;
+            copyContext(other);
         }
-        return Result<OkType, ErrType>(std::move(*std::get_if<ErrType>(&_result)));
+        return *this;
     }
 
-    /// @brief Maps a custom/lambda function to the [ErrType] leaving the [OkType] untouched.
+    /// @brief Allocator extended copy and move, used by allocator aware containers and Result
+    BasicError(std::allocator_arg_t, Allocator const &allocator, BasicError const &other)
+        : IError(other), internal::ErrorBacktrace(other), _msg(other._msg, allocator), _location(other._location)
+    {
+        copyContext(other);
+    }
+
+    BasicError(std::allocator_arg_t, Allocator const &allocator, BasicError &&other)
+        : IError(other), internal::ErrorBacktrace(other), _msg(std::move(other._msg), allocator),
+          _location(std::move(other._location))
+    {
+        adoptContext(std::move(other));
+    }
+
+  public:
+    /// @brief Creates an Error object with only an error message via string_view
+    [[nodiscard]] inline static auto create(std::string_view const &msg) -> BasicError
+    {
+        return BasicError(msg, internal::DefaultErrorAllocator<Allocator>::get());
+    }
+
+    /// @brief Creates an Error object with error message and source location information
+    [[nodiscard]] inline static auto create(std::string_view const &msg, SourceCodeLocation const &slc) -> BasicError
+    {
+        return BasicError(msg, slc, internal::DefaultErrorAllocator<Allocator>::get());
+    }
+
+    /// @brief Creates an Error object whose message is stored with `allocator`
+    [[nodiscard]] inline static auto create(std::string_view const &msg, Allocator const &allocator) -> BasicError
+    {
+        return BasicError(msg, allocator);
+    }
+
+    /// @brief Creates an Error object with source location information, whose message is stored with `allocator`
+    [[nodiscard]] inline static auto create(std::string_view const &msg, SourceCodeLocation const &slc,
+                                            Allocator const &allocator) -> BasicError
+    {
+        return BasicError(msg, slc, allocator);
+    }
+
+  public:
+    /// @brief Attaches a frame of context, like "while parsing header", keeping the original message.
     ///
-    /// @details The use should always use the is_err() method before using mapErr().
+    /// @example tests/result_test.cpp
+    inline auto context(std::string_view const &msg, SourceCodeLocation const &slc) & -> BasicError &
+    {
+        pushFrame(msg, slc);
+        return *this;
+    }
+
+    inline auto context(std::string_view const &msg, SourceCodeLocation const &slc) && -> BasicError &&
+    {
+        pushFrame(msg, slc);
+        return std::move(*this);
+    }
+
+    /// @brief Attaches a frame of context without a source location.
+    inline auto context(std::string_view const &msg) & -> BasicError &
+    {
+        pushFrame(msg, std::nullopt);
+        return *this;
+    }
+
+    inline auto context(std::string_view const &msg) && -> BasicError &&
+    {
+        pushFrame(msg, std::nullopt);
+        return std::move(*this);
+    }
+
+    /// @brief Get how many frames of context were attached
+    [[nodiscard]] inline auto context_count() const noexcept -> std::size_t
+    {
+        return _context == nullptr ? 0 : _context->frameCount;
+    }
+
+    /// @brief Get the message of a context frame, frames are numbered in the order they were attached
+    [[nodiscard]] inline auto context_message(std::size_t index) const noexcept -> std::string_view
+    {
+        auto const &contextFrame = frame(index);
+        if (contextFrame.offset < block_context_text)
+        {
+            return std::string_view(_context->text.data() + contextFrame.offset, contextFrame.length);
+        }
+        return std::string_view(_context->spilledText).substr(contextFrame.offset - block_context_text,
+                                                             contextFrame.length);
+    }
+
+    /// @brief Get the source location of a context frame, if it was attached with RUNTIME_INFO
+    [[nodiscard]] inline auto context_location(std::size_t index) const noexcept
+        -> std::optional<SourceCodeLocation> const &
+    {
+        return frame(index).location;
+    }
+
+    /// @brief Get just the error message
+    [[nodiscard]] inline auto msg() const noexcept -> std::string override
+    {
+        return std::string(_msg);
+    }
+
+    /// @brief Get the error message without copying it
+    [[nodiscard]] inline auto view() const noexcept -> std::string_view
+    {
+        return _msg;
+    }
+
+    /// @brief Override the current error message, useful when using the Result.mapErr method.
+    [[nodiscard]] inline auto set(std::string_view const &msg) noexcept
+    {
+        _msg = msg;
+    }
+
+    /// @brief Get the allocator the message is stored with
+    [[nodiscard]] inline auto get_allocator() const noexcept -> Allocator
+    {
+        return _msg.get_allocator();
+    }
+
+    /// @brief Get the source location the error was created at, if it was created with RUNTIME_INFO.
+    [[nodiscard]] inline auto location() const noexcept -> std::optional<SourceCodeLocation> const &
+    {
+        return _location;
+    }
+
+    /// @brief Get the pretty printed error string.
     ///
-    /// @return Returns the Result type with a modified ErrType, or just the Result unmodified
-    /// if is_err() is false.
-    template <typename Function>
-    [[nodiscard]] inline auto map_err(Function &&func) const noexcept -> Result<OkType, ErrType>
+    /// @details If Error was not created with the RUNTIME_INFO macro and has no context there is nothing
+    /// to print but the message, in which case the msg_ will be returned instead. Context frames follow the
+    /// error, in the order they were attached, then the backtrace if one was captured.
+    [[nodiscard]] inline auto info() const noexcept -> std::string override
     {
-        if (!_is_ok)
+        if (!_location.has_value() && context_count() == 0 && backtrace_depth() == 0)
         {
-            if constexpr (std::is_invocable_r_v<ErrType, Function, ErrType const &>)
+            return msg();
+        }
+        std::string info;
+        info.append("Error: ").append(_msg);
+        internal::append_location(info, _location, "");
+        for (std::size_t index = 0; index < context_count(); ++index)
+        {
+            info.append("\nContext: ").append(context_message(index));
+            internal::append_location(info, context_location(index), "  ");
+        }
+        append_backtrace(info);
+        return info;
+    }
+
+  private:
+    [[nodiscard]] auto allocateContext(ContextBlock const *other) -> ContextBlock *
+    {
+        block_allocator_type allocator(get_allocator());
+        auto *block = block_traits::allocate(allocator, 1);
+        try
+        {
+            if (other == nullptr)
             {
-                return Result<OkType, ErrType>(
-                    std::invoke(std::forward<Function>(func), *std::get_if<ErrType>(&_result)));
+                block_traits::construct(allocator, block, get_allocator());
             }
             else
             {
-                return Result<OkType, ErrType>(*std::get_if<ErrType>(&_result));
+                block_traits::construct(allocator, block, *other, get_allocator());
             }
         }
-        return Result<OkType, ErrType>(std::move(*std::get_if<OkType>(&_result)));
+        catch (...)
+        {
+            block_traits::deallocate(allocator, block, 1);
+            throw;
+        }
+        return block;
+    }
+
+    /// @brief The block is always owned through the message's allocator, so that is what frees it.
+    auto destroyContext() noexcept -> void
+    {
+        if (_context != nullptr)
+        {
+            block_allocator_type allocator(get_allocator());
+            block_traits::destroy(allocator, _context);
+            block_traits::deallocate(allocator, _context, 1);
+            _context = nullptr;
+        }
+    }
+
+    auto copyContext(BasicError const &other) -> void
+    {
+        if (other._context != nullptr)
+        {
+            _context = allocateContext(other._context);
+        }
+    }
+
+    /// @brief Called once the message has been moved, steals the block when both allocators can free it.
+    auto adoptContext(BasicError &&other) -> void
+    {
+        if (get_allocator() == other.get_allocator())
+        {
+            _context = std::exchange(other._context, nullptr);
+        }
+        else
+        {
+            copyContext(other);
+        }
+    }
+
+    auto pushFrame(std::string_view const &msg, std::optional<SourceCodeLocation> const &slc) -> void
+    {
+        if (_context == nullptr)
+        {
+            _context = allocateContext(nullptr);
+        }
+        auto &block = *_context;
+        ContextFrame contextFrame{0, static_cast<uint32_t>(msg.size()), slc};
+        if (block.spilledText.empty() && msg.size() <= block_context_text - block.textSize)
+        {
+            contextFrame.offset = static_cast<uint32_t>(block.textSize);
+            std::copy(msg.begin(), msg.end(), block.text.begin() + static_cast<std::ptrdiff_t>(block.textSize));
+            block.textSize += msg.size();
+        }
+        else
+        {
+            contextFrame.offset = static_cast<uint32_t>(block_context_text + block.spilledText.size());
+            block.spilledText.append(msg);
+        }
+        if (block.frameCount < block_context_frames)
+        {
+            block.frames[block.frameCount] = std::move(contextFrame);
+        }
+        else
+        {
+            block.spilledFrames.push_back(std::move(contextFrame));
+        }
+        ++block.frameCount;
+    }
+
+    [[nodiscard]] auto frame(std::size_t index) const noexcept -> ContextFrame const &
+    {
+        return index < block_context_frames ? _context->frames[index]
+                                            : _context->spilledFrames[index - block_context_frames];
     }
 };
 
-/// @brief Result Template Specialization for std::unique_ptr.
+/// @brief The general purpose error, its message is heap allocated.
+using Error = BasicError<std::allocator<char>>;
+
+namespace pmr
+{
+/// @brief An error whose message lives in a std::pmr::memory_resource.
+using Error = BasicError<std::pmr::polymorphic_allocator<char>>;
+} // namespace pmr
+
+/// @brief An error for predictable, expected failures which never allocates.
 ///
-/// @details Since std::unique_ptr is a move only type, the generic Result implementation
-/// confuses which constructors are to be used and its not enough. Objects with deleted copy constructors
-/// will need a templated specialization. You can use this specialiation for your custom type as
-/// an example on how to do it.
-template <typename OkType, typename ErrType> class Result<std::unique_ptr<OkType>, ErrType>
+/// @details Holds a view of a message with static storage duration, usually a string literal, and an
+/// optional error code. Creating, copying or returning one copies a few words, which makes it cheap enough
+/// for errors that are part of normal control flow, like running out of input. Only msg() and info(),
+/// which IError requires to return a std::string, build a string, and only when they are called.
+///
+/// @example tests/result_test.cpp
+class StaticError : public IError
 {
   private:
-    std::variant<std::unique_ptr<OkType>, ErrType> _result;
-    bool _is_ok{false};
+    std::string_view _msg;
+    int32_t _code{0};
+
+  private:
+    /// @brief This constructor is private to prevent the user from circumventing the create() method
+    StaticError(std::string_view const &msg, int32_t code) noexcept : _msg(msg), _code(code)
+    {
+    }
 
   public:
-    /// @brief All the constructors needed to build an OkType or ErrType for a move only type
-    Result() noexcept = default;
-    explicit Result(std::unique_ptr<OkType> &&value) noexcept : _result(std::move(value)), _is_ok(true)
+    /// @brief Default Destructor, Move/Copy constructor and assignment
+    ~StaticError() override = default;
+    StaticError(StaticError &&other) noexcept = default;
+    auto operator=(StaticError &&other) noexcept -> StaticError & = default;
+    StaticError(StaticError const &other) = default;
+    auto operator=(StaticError const &other) -> StaticError & = default;
+
+  public:
+    /// @brief Creates a StaticError, `msg` must outlive it, a string literal always does.
+    [[nodiscard]] inline static auto create(std::string_view const &msg, int32_t code = 0) noexcept -> StaticError
     {
+        return StaticError(msg, code);
     }
-    explicit Result(ErrType const &error) noexcept : _result(error)
+
+  public:
+    /// @brief Get the error message without copying it
+    [[nodiscard]] inline auto view() const noexcept -> std::string_view
+    {
+        return _msg;
+    }
+
+    /// @brief Get the error code, zero unless one was given to create()
+    [[nodiscard]] inline auto code() const noexcept -> int32_t
     {
+        return _code;
     }
-    explicit Result(ErrType &&error) noexcept : _result(std::move(error))
+
+    /// @brief Get the error message as a string
+    [[nodiscard]] inline auto msg() const noexcept -> std::string override
     {
+        return std::string(_msg);
     }
 
-  public:
-    /// @brief Check if the variant value is of the [OkType]
-    [[nodiscard]] inline auto is_ok() const noexcept -> bool
+    /// @brief A StaticError carries no source location, so this is the message
+    [[nodiscard]] inline auto info() const noexcept -> std::string override
     {
-        return _is_ok;
+        return std::string(_msg);
     }
 
-    /// @brief Check if the variant value is of the [ErrType]
-    [[nodiscard]] inline auto is_err() const noexcept -> bool
+    /// @brief Two static errors are the same error when their code and message match
+    [[nodiscard]] inline auto operator==(StaticError const &other) const noexcept -> bool
     {
-        return !_is_ok;
+        return _code == other._code && _msg == other._msg;
     }
 
-    /// @brief Gets the [OkType] value from the variant
-    ///
-    /// @details The user should always use the is_ok() method before using ok()
+    [[nodiscard]] inline auto operator!=(StaticError const &other) const noexcept -> bool
+    {
+        return !(*this == other);
+    }
+};
+
+#if ETL_HAS_ERROR_SINK
+/// @brief What an ErrorSink does when its queue is full.
+enum class OverflowPolicy : uint8_t
+{
+    /// @brief Throw the record away and count it, the caller never waits.
+    Drop,
+    /// @brief Wait for the writer thread to make room.
+    Block,
+};
+
+/// @brief Writes errors to a file descriptor from a background thread, in batches.
+///
+/// @details push() copies the raw parts of an error, its message, context messages and the views of its
+/// source locations, into a slot of a bounded lock-free multi producer, single consumer ring, and returns.
+/// The writer thread formats whatever has queued up and hands it to a single write() call, so the thread
+/// that hit the error never formats a line number or blocks on the file descriptor. Each record is written
+/// as info() would format the error, followed by a newline.
+///
+/// Messages longer than `record_capacity` are truncated, and only the first `record_context_frames` context
+/// frames keep their locations. Locations are kept as views, which is safe for those from RUNTIME_INFO.
+/// shutdown(), also run by the destructor, writes everything still queued before it returns, and flush()
+/// waits until everything pushed so far has been written. Only available with ETL_ERROR_SINK defined.
+///
+/// @example tests/result_test.cpp
+class ErrorSink
+{
+  public:
+    /// @brief Bytes of message kept per record, context messages included.
+    static constexpr std::size_t record_capacity = 192;
+
+    /// @brief Context frames per record whose source locations are kept.
+    static constexpr std::size_t record_context_frames = 4;
+
+    /// @brief The writer formats at most this many records per write() call.
+    static constexpr std::size_t batch_size = 64;
+
+  private:
+    /// @brief Where the text of a context frame ends, and where that frame was attached.
+    class RecordFrame
+    {
+      public:
+        uint16_t end{0};
+        std::optional<SourceCodeLocation> location;
+    };
+
+    /// @brief An error as it was pushed, nothing in it is formatted yet. The text holds the message, then
+    /// every "\nContext: " line, the frames mark where the location of each of the first ones goes.
+    class Record
+    {
+      public:
+        std::array<char, record_capacity> text{};
+        uint16_t length{0};
+        uint16_t messageLength{0};
+        std::optional<SourceCodeLocation> location;
+        std::array<RecordFrame, record_context_frames> frames{};
+        std::size_t frameCount{0};
+    };
+
+    /// @brief A ring slot, the sequence number says whose turn it is: the producer writing lap `n` waits
+    /// for `n`, the consumer waits for `n + 1`.
+    class alignas(internal::cache_line_size) Slot
+    {
+      public:
+        std::atomic<std::size_t> sequence{0};
+        Record record;
+    };
+
+    int _fd;
+    OverflowPolicy _policy;
+    std::unique_ptr<Slot[]> _slots;
+    std::size_t _mask;
+
+    alignas(internal::cache_line_size) std::atomic<std::size_t> _enqueuePos{0};
+    alignas(internal::cache_line_size) std::size_t _dequeuePos{0};
+    std::atomic<std::size_t> _written{0};
+    std::atomic<uint64_t> _dropped{0};
+    std::atomic<bool> _sleeping{false};
+    std::atomic<bool> _stopping{false};
+    std::atomic<bool> _stopped{false};
+    std::atomic<std::size_t> _producers{0};
+
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::condition_variable _flushed;
+    std::thread _writer;
+
+  public:
+    /// @brief Starts the writer thread.
     ///
-    /// @return std::optinal<OkType> for safety, incase the user did not call
-    /// is_ok() before using this method.
-    [[nodiscard]] inline auto ok() const noexcept -> std::optional<std::unique_ptr<OkType>>
+    /// @param `fd` the file descriptor to write to, it is not closed by the sink
+    /// @param `capacity` how many records can be queued, rounded up to a power of two
+    /// @param `policy` what push() does when the queue is full
+    explicit ErrorSink(int fd, std::size_t capacity = 1024, OverflowPolicy policy = OverflowPolicy::Drop)
+        : _fd(fd), _policy(policy)
     {
-        if (_is_ok)
+        std::size_t slots = 2;
+        while (slots < capacity)
         {
-            if (auto *value = std::get_if<std::unique_ptr<OkType>>(&_result))
-            {
-                return std::make_unique<OkType>(**value);
-            }
+            slots <<= 1U;
         }
-        return std::nullopt;
+        _slots = std::make_unique<Slot[]>(slots);
+        _mask = slots - 1;
+        for (std::size_t i = 0; i < slots; ++i)
+        {
+            _slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        _writer = std::thread([this] { run(); });
     }
 
-    /// @brief Get the [ErrType] value from the variant
+    /// @brief Writes every queued record, then stops the writer thread
+    ~ErrorSink()
+    {
+        shutdown();
+    }
+
+    ErrorSink(ErrorSink &&other) noexcept = delete;
+    auto operator=(ErrorSink &&other) noexcept -> ErrorSink & = delete;
+    ErrorSink(ErrorSink const &other) = delete;
+    auto operator=(ErrorSink const &other) -> ErrorSink & = delete;
+
+  public:
+    /// @brief Queues an error with its source location and context.
     ///
-    /// @details The user should always use the is_err() method before using err()
+    /// @return false if the record was dropped, because the queue was full or the sink is shut down
+    template <typename Allocator> auto push(BasicError<Allocator> const &error) noexcept -> bool
+    {
+        return enqueue([&error](Record &record) {
+            append(record, error.view());
+            record.messageLength = record.length;
+            record.location = error.location();
+            for (std::size_t index = 0; index < error.context_count(); ++index)
+            {
+                append(record, "\nContext: ");
+                append(record, error.context_message(index));
+                if (index < record_context_frames)
+                {
+                    record.frames[index].end = record.length;
+                    record.frames[index].location = error.context_location(index);
+                    ++record.frameCount;
+                }
+            }
+        });
+    }
+
+    /// @brief Queues a static error, its message is copied, never formatted.
+    auto push(StaticError const &error) noexcept -> bool
+    {
+        return enqueue([&error](Record &record) {
+            append(record, error.view());
+            record.messageLength = record.length;
+        });
+    }
+
+    /// @brief Queues any other error, IError only offers an allocated msg(), so this one is not free.
+    auto push(IError const &error) -> bool
+    {
+        const auto msg = error.msg();
+        return enqueue([&msg](Record &record) {
+            append(record, msg);
+            record.messageLength = record.length;
+        });
+    }
+
+    /// @brief Waits until every record pushed before the call has been written.
+    auto flush() -> void
+    {
+        const auto target = _enqueuePos.load(std::memory_order_acquire);
+        std::unique_lock<std::mutex> lock(_mutex);
+        _wake.notify_one();
+        _flushed.wait(lock, [this, target] {
+            return _written.load(std::memory_order_acquire) >= target || _stopped.load(std::memory_order_acquire);
+        });
+    }
+
+    /// @brief Stops accepting records, writes everything already queued and joins the writer thread.
     ///
-    /// @return std::optinal<ErrType> for safety, incase the user did not call
-    /// is_err() before using this method.
-    [[nodiscard]] inline auto err() const noexcept -> std::optional<ErrType>
+    /// @details Safe to call more than once, call it from a shutdown hook to not lose the last errors.
+    /// A push() racing with shutdown() either has its record written before this returns, or returns false.
+    auto shutdown() -> void
     {
-        if (!_is_ok)
         {
-            if (auto *err = std::get_if<ErrType>(&_result))
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_stopping.exchange(true))
             {
-                return *err;
+                return;
             }
+            _wake.notify_one();
         }
-        return std::nullopt;
+        _writer.join();
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopped.store(true, std::memory_order_release);
+        _flushed.notify_all();
     }
-};
 
-} // namespace etl
+    /// @brief Get how many records were dropped because the queue was full
+    [[nodiscard]] auto dropped() const noexcept -> uint64_t
+    {
+        return _dropped.load(std::memory_order_relaxed);
+    }
+
+  private:
+    static auto append(Record &record, std::string_view const &text) noexcept -> void
+    {
+        const auto count = std::min<std::size_t>(text.size(), record.text.size() - record.length);
+        std::copy_n(text.data(), count, record.text.data() + record.length);
+        record.length = static_cast<uint16_t>(record.length + count);
+    }
+
+    /// @brief Counts the producer in for as long as it may touch the ring, so the writer thread does not
+    /// stop while a record it was promised is still being claimed or filled.
+    template <typename Fill> auto enqueue(Fill &&fill) noexcept -> bool
+    {
+        // Counted before _stopping is read, pairs with the writer reading the count after _stopping is set.
+        _producers.fetch_add(1, std::memory_order_seq_cst);
+        const auto queued = !_stopping.load(std::memory_order_seq_cst) && claim(fill);
+        _producers.fetch_sub(1, std::memory_order_release);
+        return queued;
+    }
+
+    /// @brief Claims a slot, lets `fill` write the record into it, then publishes it to the writer.
+    template <typename Fill> auto claim(Fill &fill) noexcept -> bool
+    {
+        auto pos = _enqueuePos.load(std::memory_order_relaxed);
+        Slot *slot = nullptr;
+        while (true)
+        {
+            slot = &_slots[pos & _mask];
+            const auto sequence = slot->sequence.load(std::memory_order_acquire);
+            if (sequence == pos)
+            {
+                if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (sequence < pos)
+            {
+                // Full, the writer has not freed this slot from the previous lap yet.
+                if (_policy == OverflowPolicy::Drop)
+                {
+                    _dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                if (_stopping.load(std::memory_order_relaxed))
+                {
+                    return false;
+                }
+                wakeWriter();
+                std::this_thread::yield();
+                pos = _enqueuePos.load(std::memory_order_relaxed);
+            }
+            else
+            {
+                pos = _enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->record.length = 0;
+        slot->record.messageLength = 0;
+        slot->record.location.reset();
+        slot->record.frameCount = 0;
+        fill(slot->record);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+
+        // Pairs with the fence in run(), either the writer sees the record or we see it asleep.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_sleeping.load(std::memory_order_relaxed))
+        {
+            wakeWriter();
+        }
+        return true;
+    }
+
+    auto wakeWriter() noexcept -> void
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _wake.notify_one();
+    }
+
+    [[nodiscard]] auto readable() const noexcept -> bool
+    {
+        return _slots[_dequeuePos & _mask].sequence.load(std::memory_order_acquire) == _dequeuePos + 1;
+    }
+
+    /// @brief Lays the record out the way BasicError::info() does.
+    static auto format(Record const &record, std::string &out) -> void
+    {
+        if (!record.location.has_value() && record.length == record.messageLength)
+        {
+            out.append(record.text.data(), record.length).append("\n");
+            return;
+        }
+        out.append("Error: ").append(record.text.data(), record.messageLength);
+        internal::append_location(out, record.location, "");
+        std::size_t offset = record.messageLength;
+        for (std::size_t index = 0; index < record.frameCount; ++index)
+        {
+            auto const &frame = record.frames[index];
+            out.append(record.text.data() + offset, frame.end - offset);
+            internal::append_location(out, frame.location, "  ");
+            offset = frame.end;
+        }
+        out.append(record.text.data() + offset, record.length - offset).append("\n");
+    }
+
+    auto writeAll(std::string const &out) noexcept -> void
+    {
+        std::size_t offset = 0;
+        while (offset < out.size())
+        {
+            const auto result = ::write(_fd, out.data() + offset, out.size() - offset);
+            if (result < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (result <= 0)
+            {
+                return;
+            }
+            offset += static_cast<std::size_t>(result);
+        }
+    }
+
+    /// @brief The writer thread, drains a batch at a time and sleeps when there is nothing to do.
+    auto run() -> void
+    {
+        std::string out;
+        while (true)
+        {
+            out.clear();
+            std::size_t count = 0;
+            while (count < batch_size && readable())
+            {
+                auto &slot = _slots[_dequeuePos & _mask];
+                format(slot.record, out);
+                slot.sequence.store(_dequeuePos + _mask + 1, std::memory_order_release);
+                ++_dequeuePos;
+                ++count;
+            }
+            if (count > 0)
+            {
+                writeAll(out);
+                _written.fetch_add(count, std::memory_order_release);
+                std::lock_guard<std::mutex> lock(_mutex);
+                _flushed.notify_all();
+                continue;
+            }
+
+            if (_stopping.load(std::memory_order_seq_cst))
+            {
+                // Producers that read _stopping before it was set may still claim and fill slots, once none
+                // is left _enqueuePos is final.
+                if (_producers.load(std::memory_order_seq_cst) == 0 &&
+                    _dequeuePos == _enqueuePos.load(std::memory_order_acquire))
+                {
+                    return;
+                }
+                std::this_thread::yield();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            _sleeping.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!readable() && !_stopping.load(std::memory_order_relaxed))
+            {
+                _wake.wait_for(lock, std::chrono::milliseconds(10));
+            }
+            _sleeping.store(false, std::memory_order_relaxed);
+        }
+    }
+};
+#endif
+
+/// @brief Empty stub type for when the user wants a result with an Ok type
+/// with no value, since c++ doesn't have rusts () type, this is my workaround.
+///
+/// @details In Rust it would be Result<(), String>.
+/// Converted into this C++ class would be, Result<Void, std::string>.
+class Void
+{
+};
+
+namespace internal
+{
+class ResultAccess;
+} // namespace internal
+
+/// @brief Generic Result type modeled after the Rust lanaguage's Result<T, E>
+template <typename OkType, typename ErrType> class Result
+{
+  private:
+    friend class internal::ResultAccess;
+
+    std::variant<OkType, ErrType> _result;
+    bool _is_ok{false};
+
+  public:
+    /// @brief All the constructors needed to build an OkType or ErrType
+    Result() noexcept = default;
+    explicit Result(OkType const &value) noexcept : _result(value), _is_ok(true)
+    {
+    }
+    explicit Result(OkType &&value) noexcept : _result(std::move(value)), _is_ok(true)
+    {
+    }
+    explicit Result(ErrType const &error) noexcept : _result(error)
+    {
+    }
+    explicit Result(ErrType &&error) noexcept : _result(std::move(error))
+    {
+    }
+
+    /// @brief Allocator extended constructors.
+    ///
+    /// @details The payload is built with `allocator` whenever it uses one, so a Result holding, say, a
+    /// std::pmr::string or an etl::pmr::Error lives entirely in the caller's memory resource. Allocator
+    /// aware containers, like a std::pmr::vector of results, pick these up on their own.
+    template <typename Allocator>
+    Result(std::allocator_arg_t, Allocator const &allocator)
+        : _result(std::in_place_index<0>, internal::make_using_allocator<OkType>(allocator))
+    {
+    }
+    template <typename Allocator>
+    Result(std::allocator_arg_t, Allocator const &allocator, OkType const &value)
+        : _result(std::in_place_index<0>, internal::make_using_allocator<OkType>(allocator, value)), _is_ok(true)
+    {
+    }
+    template <typename Allocator>
+    Result(std::allocator_arg_t, Allocator const &allocator, OkType &&value)
+        : _result(std::in_place_index<0>, internal::make_using_allocator<OkType>(allocator, std::move(value))),
+          _is_ok(true)
+    {
+    }
+    template <typename Allocator>
+    Result(std::allocator_arg_t, Allocator const &allocator, ErrType const &error)
+        : _result(std::in_place_index<1>, internal::make_using_allocator<ErrType>(allocator, error))
+    {
+    }
+    template <typename Allocator>
+    Result(std::allocator_arg_t, Allocator const &allocator, ErrType &&error)
+        : _result(std::in_place_index<1>, internal::make_using_allocator<ErrType>(allocator, std::move(error)))
+    {
+    }
+    template <typename Allocator>
+    Result(std::allocator_arg_t, Allocator const &allocator, Result const &other)
+        : _result(rebind(allocator, other._result)), _is_ok(other._is_ok)
+    {
+    }
+    template <typename Allocator>
+    Result(std::allocator_arg_t, Allocator const &allocator, Result &&other)
+        : _result(rebind(allocator, std::move(other._result))), _is_ok(other._is_ok)
+    {
+    }
+
+    /// @brief Default Destructor, Move/Copy constructor and assignment
+    virtual ~Result() = default;
+    Result(Result &&other) noexcept = default;
+    auto operator=(Result &&other) noexcept -> Result & = default;
+    Result(const Result &other) = default;
+    auto operator=(const Result &other) -> Result & = default;
+
+  private:
+    /// @brief Copies or moves whichever alternative `other` holds, with `allocator`.
+    template <typename Allocator, typename Variant>
+    [[nodiscard]] static auto rebind(Allocator const &allocator, Variant &&other) -> std::variant<OkType, ErrType>
+    {
+        if (other.index() == 0)
+        {
+            return std::variant<OkType, ErrType>(
+                std::in_place_index<0>,
+                internal::make_using_allocator<OkType>(allocator, std::get<0>(std::forward<Variant>(other))));
+        }
+        return std::variant<OkType, ErrType>(
+            std::in_place_index<1>,
+            internal::make_using_allocator<ErrType>(allocator, std::get<1>(std::forward<Variant>(other))));
+    }
+
+  public:
+    /// @brief Check if the variant is of the [OkType]
+    [[nodiscard]] inline auto is_ok() const noexcept -> bool
+    {
+        return _is_ok;
+    }
+
+    /// @brief Check if the variant is of the [ErrType]
+    [[nodiscard]] inline auto is_err() const noexcept -> bool
+    {
+        return !_is_ok;
+    }
+
+    /// @brief Get the OkType value
+    ///
+    /// @details The use should always use is_ok() before using ok()
+    ///
+    /// @return std::optinal<OkType> for safety, incase the user did not call
+    /// is_ok() before using this method.
+    [[nodiscard]] inline auto ok() const & noexcept -> std::optional<OkType>
+    {
+        if (_is_ok)
+        {
+            if (auto *value = std::get_if<OkType>(&_result))
+            {
+                return *value;
+            }
+        }
+        return std::nullopt;
+    }
+
+    /// @brief Moves the OkType value out of a Result that is about to go away
+    [[nodiscard]] inline auto ok() && noexcept -> std::optional<OkType>
+    {
+        if (_is_ok)
+        {
+            if (auto *value = std::get_if<OkType>(&_result))
+            {
+                return std::move(*value);
+            }
+        }
+        return std::nullopt;
+    }
+
+    /// @brief Get the ErrType value
+    ///
+    /// @details The use should always use is_err() before using err()
+    ///
+    /// @return std::optinal<ErrType> for safety, incase the user did not call
+    /// is_err() before using this method.
+    [[nodiscard]] inline auto err() const & noexcept -> std::optional<ErrType>
+    {
+        if (!_is_ok)
+        {
+            if (auto *err = std::get_if<ErrType>(&_result))
+            {
+                return *err;
+            }
+        }
+        return std::nullopt;
+    }
+
+    /// @brief Moves the ErrType value out of a Result that is about to go away
+    [[nodiscard]] inline auto err() && noexcept -> std::optional<ErrType>
+    {
+        if (!_is_ok)
+        {
+            if (auto *err = std::get_if<ErrType>(&_result))
+            {
+                return std::move(*err);
+            }
+        }
+        return std::nullopt;
+    }
+
+    /// @brief Maps a custom/lambda function to the [OkType] leaving the [ErrType] untouched.
+    ///
+    /// @details The use should always use is_ok() before using map()
+    ///
+    /// @return Returns the Result type with a modified OkType, or just the Result unmodified
+    /// if is_ok() is false.
+    template <typename Function>
+    [[nodiscard]] inline auto map(Function &&func) const noexcept -> Result<OkType, ErrType>
+    {
+        if (_is_ok)
+        {
+            if constexpr (std::is_invocable_r_v<OkType, Function, OkType const &>)
+            {
+                return Result<OkType, ErrType>(
+                    std::invoke(std::forward<Function>(func), *std::get_if<OkType>(&_result)));
+            }
+            else
+            {
+                return Result<OkType, ErrType>(*std::get_if<OkType>(&_result));
+            }
+        }
+        return Result<OkType, ErrType>(std::move(*std::get_if<ErrType>(&_result)));
+    }
+
+    /// @brief Maps a custom/lambda function to the [ErrType] leaving the [OkType] untouched.
+    ///
+    /// @details The use should always use the is_err() method before using mapErr().
+    ///
+    /// @return Returns the Result type with a modified ErrType, or just the Result unmodified
+    /// if is_err() is false.
+    template <typename Function>
+    [[nodiscard]] inline auto map_err(Function &&func) const noexcept -> Result<OkType, ErrType>
+    {
+        if (!_is_ok)
+        {
+            if constexpr (std::is_invocable_r_v<ErrType, Function, ErrType const &>)
+            {
+                return Result<OkType, ErrType>(
+                    std::invoke(std::forward<Function>(func), *std::get_if<ErrType>(&_result)));
+            }
+            else
+            {
+                return Result<OkType, ErrType>(*std::get_if<ErrType>(&_result));
+            }
+        }
+        return Result<OkType, ErrType>(std::move(*std::get_if<OkType>(&_result)));
+    }
+};
+
+/// @brief Result Template Specialization for std::unique_ptr.
+///
+/// @details Since std::unique_ptr is a move only type, the generic Result implementation
+/// confuses which constructors are to be used and its not enough. Objects with deleted copy constructors
+/// will need a templated specialization. You can use this specialiation for your custom type as
+/// an example on how to do it.
+template <typename OkType, typename ErrType> class Result<std::unique_ptr<OkType>, ErrType>
+{
+  private:
+    friend class internal::ResultAccess;
+
+    std::variant<std::unique_ptr<OkType>, ErrType> _result;
+    bool _is_ok{false};
+
+  public:
+    /// @brief All the constructors needed to build an OkType or ErrType for a move only type
+    Result() noexcept = default;
+    explicit Result(std::unique_ptr<OkType> &&value) noexcept : _result(std::move(value)), _is_ok(true)
+    {
+    }
+    explicit Result(ErrType const &error) noexcept : _result(error)
+    {
+    }
+    explicit Result(ErrType &&error) noexcept : _result(std::move(error))
+    {
+    }
+
+    /// @brief Allocator extended constructors, only the [ErrType] can use the allocator.
+    template <typename Allocator>
+    Result(std::allocator_arg_t, Allocator const & /*allocator*/, std::unique_ptr<OkType> &&value) noexcept
+        : _result(std::move(value)), _is_ok(true)
+    {
+    }
+    template <typename Allocator>
+    Result(std::allocator_arg_t, Allocator const &allocator, ErrType const &error)
+        : _result(std::in_place_index<1>, internal::make_using_allocator<ErrType>(allocator, error))
+    {
+    }
+    template <typename Allocator>
+    Result(std::allocator_arg_t, Allocator const &allocator, ErrType &&error)
+        : _result(std::in_place_index<1>, internal::make_using_allocator<ErrType>(allocator, std::move(error)))
+    {
+    }
+    template <typename Allocator>
+    Result(std::allocator_arg_t, Allocator const &allocator, Result &&other) : _is_ok(other._is_ok)
+    {
+        if (other._result.index() == 0)
+        {
+            _result.template emplace<0>(std::move(std::get<0>(other._result)));
+        }
+        else
+        {
+            _result.template emplace<1>(
+                internal::make_using_allocator<ErrType>(allocator, std::move(std::get<1>(other._result))));
+        }
+    }
+
+  public:
+    /// @brief Check if the variant value is of the [OkType]
+    [[nodiscard]] inline auto is_ok() const noexcept -> bool
+    {
+        return _is_ok;
+    }
+
+    /// @brief Check if the variant value is of the [ErrType]
+    [[nodiscard]] inline auto is_err() const noexcept -> bool
+    {
+        return !_is_ok;
+    }
+
+    /// @brief Gets the [OkType] value from the variant
+    ///
+    /// @details The user should always use the is_ok() method before using ok()
+    ///
+    /// @return std::optinal<OkType> for safety, incase the user did not call
+    /// is_ok() before using this method.
+    [[nodiscard]] inline auto ok() const & noexcept -> std::optional<std::unique_ptr<OkType>>
+    {
+        if (_is_ok)
+        {
+            if (auto *value = std::get_if<std::unique_ptr<OkType>>(&_result))
+            {
+                return std::make_unique<OkType>(**value);
+            }
+        }
+        return std::nullopt;
+    }
+
+    /// @brief Hands over the owned [OkType] of a Result that is about to go away, without copying it
+    [[nodiscard]] inline auto ok() && noexcept -> std::optional<std::unique_ptr<OkType>>
+    {
+        if (_is_ok)
+        {
+            if (auto *value = std::get_if<std::unique_ptr<OkType>>(&_result))
+            {
+                return std::move(*value);
+            }
+        }
+        return std::nullopt;
+    }
+
+    /// @brief Get the [ErrType] value from the variant
+    ///
+    /// @details The user should always use the is_err() method before using err()
+    ///
+    /// @return std::optinal<ErrType> for safety, incase the user did not call
+    /// is_err() before using this method.
+    [[nodiscard]] inline auto err() const & noexcept -> std::optional<ErrType>
+    {
+        if (!_is_ok)
+        {
+            if (auto *err = std::get_if<ErrType>(&_result))
+            {
+                return *err;
+            }
+        }
+        return std::nullopt;
+    }
+
+    /// @brief Moves the ErrType value out of a Result that is about to go away
+    [[nodiscard]] inline auto err() && noexcept -> std::optional<ErrType>
+    {
+        if (!_is_ok)
+        {
+            if (auto *err = std::get_if<ErrType>(&_result))
+            {
+                return std::move(*err);
+            }
+        }
+        return std::nullopt;
+    }
+};
+
+/// @brief Result Template Specialization for lvalue references, for lookups that return a view of what
+/// they found rather than a copy of it.
+///
+/// @details Stores a pointer to the referenced object, which must outlive the Result. Unlike a
+/// `Result<T *, E>` an Ok result is never null, and it can't be built from a temporary.
+template <typename OkType, typename ErrType> class Result<OkType &, ErrType>
+{
+  private:
+    std::variant<OkType *, ErrType> _result;
+    bool _is_ok{false};
+
+  public:
+    /// @brief Refers to `value`, or holds an error
+    explicit Result(OkType &value) noexcept : _result(std::addressof(value)), _is_ok(true)
+    {
+    }
+    explicit Result(ErrType const &error) noexcept : _result(error)
+    {
+    }
+    explicit Result(ErrType &&error) noexcept : _result(std::move(error))
+    {
+    }
+
+    /// @brief Would refer to a temporary that is gone by the time the Result is used
+    explicit Result(std::remove_const_t<OkType> &&value) = delete;
+
+    /// @brief Allocator extended constructors, only the [ErrType] can use the allocator.
+    template <typename Allocator>
+    Result(std::allocator_arg_t, Allocator const & /*allocator*/, OkType &value) noexcept
+        : _result(std::addressof(value)), _is_ok(true)
+    {
+    }
+    template <typename Allocator>
+    Result(std::allocator_arg_t, Allocator const &allocator, std::remove_const_t<OkType> &&value) = delete;
+    template <typename Allocator>
+    Result(std::allocator_arg_t, Allocator const &allocator, ErrType const &error)
+        : _result(std::in_place_index<1>, internal::make_using_allocator<ErrType>(allocator, error))
+    {
+    }
+    template <typename Allocator>
+    Result(std::allocator_arg_t, Allocator const &allocator, ErrType &&error)
+        : _result(std::in_place_index<1>, internal::make_using_allocator<ErrType>(allocator, std::move(error)))
+    {
+    }
+    template <typename Allocator>
+    Result(std::allocator_arg_t, Allocator const &allocator, Result const &other) : _is_ok(other._is_ok)
+    {
+        if (other._result.index() == 0)
+        {
+            _result.template emplace<0>(std::get<0>(other._result));
+        }
+        else
+        {
+            _result.template emplace<1>(internal::make_using_allocator<ErrType>(allocator, std::get<1>(other._result)));
+        }
+    }
+    template <typename Allocator>
+    Result(std::allocator_arg_t, Allocator const &allocator, Result &&other) : _is_ok(other._is_ok)
+    {
+        if (other._result.index() == 0)
+        {
+            _result.template emplace<0>(std::get<0>(other._result));
+        }
+        else
+        {
+            _result.template emplace<1>(
+                internal::make_using_allocator<ErrType>(allocator, std::move(std::get<1>(other._result))));
+        }
+    }
+
+    virtual ~Result() = default;
+    Result(Result &&other) noexcept = default;
+    auto operator=(Result &&other) noexcept -> Result & = default;
+    Result(const Result &other) = default;
+    auto operator=(const Result &other) -> Result & = default;
+
+  public:
+    /// @brief Check if the variant value refers to an [OkType]
+    [[nodiscard]] inline auto is_ok() const noexcept -> bool
+    {
+        return _is_ok;
+    }
+
+    /// @brief Check if the variant value is of the [ErrType]
+    [[nodiscard]] inline auto is_err() const noexcept -> bool
+    {
+        return !_is_ok;
+    }
+
+    /// @brief Get the referenced [OkType]
+    ///
+    /// @details The user should always use the is_ok() method before using get(), calling it on an error
+    /// terminates.
+    [[nodiscard]] inline auto get() const noexcept -> OkType &
+    {
+        return *std::get<0>(_result);
+    }
+
+    /// @brief Get a reference to the [OkType]
+    ///
+    /// @return std::optinal<std::reference_wrapper<OkType>> for safety, incase the user did not call
+    /// is_ok() before using this method, its value() converts to `OkType &`.
+    [[nodiscard]] inline auto ok() const noexcept -> std::optional<std::reference_wrapper<OkType>>
+    {
+        if (_is_ok)
+        {
+            return std::ref(get());
+        }
+        return std::nullopt;
+    }
+
+    /// @brief Get the [ErrType] value from the variant
+    [[nodiscard]] inline auto err() const & noexcept -> std::optional<ErrType>
+    {
+        if (!_is_ok)
+        {
+            if (auto *err = std::get_if<ErrType>(&_result))
+            {
+                return *err;
+            }
+        }
+        return std::nullopt;
+    }
+
+    /// @brief Moves the ErrType value out of a Result that is about to go away
+    [[nodiscard]] inline auto err() && noexcept -> std::optional<ErrType>
+    {
+        if (!_is_ok)
+        {
+            if (auto *err = std::get_if<ErrType>(&_result))
+            {
+                return std::move(*err);
+            }
+        }
+        return std::nullopt;
+    }
+
+    /// @brief Maps a custom/lambda function to the referenced [OkType] leaving the [ErrType] untouched.
+    ///
+    /// @details `func` may return a value, or another reference, say to a member of the found object, which
+    /// gives a reference Result again.
+    ///
+    /// @return A Result of whatever `func` returns, or the error
+    template <typename Function>
+    [[nodiscard]] inline auto map(Function &&func) const -> Result<std::invoke_result_t<Function, OkType &>, ErrType>
+    {
+        using MappedType = Result<std::invoke_result_t<Function, OkType &>, ErrType>;
+        if (_is_ok)
+        {
+            return MappedType(std::invoke(std::forward<Function>(func), get()));
+        }
+        return MappedType(*std::get_if<ErrType>(&_result));
+    }
+
+    /// @brief Maps a custom/lambda function to the [ErrType] leaving the reference untouched.
+    template <typename Function>
+    [[nodiscard]] inline auto map_err(Function &&func) const -> Result<OkType &, ErrType>
+    {
+        if (_is_ok)
+        {
+            return Result<OkType &, ErrType>(get());
+        }
+        return Result<OkType &, ErrType>(std::invoke(std::forward<Function>(func), *std::get_if<ErrType>(&_result)));
+    }
+};
+
+namespace internal
+{
+/// @brief Reaches the payload of a Result directly, for the algorithms below, which have already checked
+/// which one it holds and would otherwise copy it through the std::optional of ok() and err().
+class ResultAccess
+{
+  public:
+    template <typename ResultType> [[nodiscard]] static auto ok(ResultType &&result) noexcept -> decltype(auto)
+    {
+        return std::get<0>(std::forward<ResultType>(result)._result);
+    }
+
+    template <typename ResultType> [[nodiscard]] static auto err(ResultType &&result) noexcept -> decltype(auto)
+    {
+        return std::get<1>(std::forward<ResultType>(result)._result);
+    }
+};
+
+/// @brief The payload types of a Result.
+template <typename ResultType> class ResultTraits;
+
+template <typename OkType, typename ErrType> class ResultTraits<Result<OkType, ErrType>>
+{
+  public:
+    using ok_type = OkType;
+    using err_type = ErrType;
+};
+
+/// @brief What `func` returns for the elements between `first` and `last`, which has to be a Result.
+template <typename Iterator, typename Function>
+using mapped_result_t = std::remove_cv_t<std::remove_reference_t<
+    std::invoke_result_t<Function &, typename std::iterator_traits<Iterator>::reference>>>;
+
+/// @brief How many elements to reserve room for, zero unless the iterators can be walked twice.
+template <typename Iterator> [[nodiscard]] auto reserve_hint(Iterator first, Iterator last) -> std::size_t
+{
+    using category = typename std::iterator_traits<Iterator>::iterator_category;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>)
+    {
+        return static_cast<std::size_t>(std::distance(first, last));
+    }
+    else
+    {
+        return 0;
+    }
+}
+} // namespace internal
+
+/// @brief Maps `func` over [first, last) and gathers every Ok value, or stops at the first error.
+///
+/// @details `func` returns a `Result<T, E>` for each element. The values are moved straight out of each
+/// result into a vector reserved up front, nothing is copied through ok()'s std::optional.
+///
+/// @return `Result<std::vector<T>, E>` holding every value in order, or the first error
+///
+/// @example tests/result_test.cpp
+template <typename Iterator, typename Function>
+[[nodiscard]] auto collect(Iterator first, Iterator last, Function &&func) -> Result<
+    std::vector<typename internal::ResultTraits<internal::mapped_result_t<Iterator, Function>>::ok_type>,
+    typename internal::ResultTraits<internal::mapped_result_t<Iterator, Function>>::err_type>
+{
+    using traits = internal::ResultTraits<internal::mapped_result_t<Iterator, Function>>;
+    using ValuesType = std::vector<typename traits::ok_type>;
+    using CollectedType = Result<ValuesType, typename traits::err_type>;
+
+    ValuesType values;
+    values.reserve(internal::reserve_hint(first, last));
+    for (; first != last; ++first)
+    {
+        auto result = std::invoke(func, *first);
+        if (result.is_err())
+        {
+            return CollectedType(internal::ResultAccess::err(std::move(result)));
+        }
+        values.push_back(internal::ResultAccess::ok(std::move(result)));
+    }
+    return CollectedType(std::move(values));
+}
+
+/// @brief collect() over a whole range, anything std::begin() and std::end() accept.
+template <typename Range, typename Function>
+[[nodiscard]] auto collect(Range &&range, Function &&func)
+    -> decltype(collect(std::begin(range), std::end(range), std::forward<Function>(func)))
+{
+    return collect(std::begin(range), std::end(range), std::forward<Function>(func));
+}
+
+/// @brief Maps `func` over [first, last) like collect(), but keeps going after an error and gathers
+/// every one of them, for reporting all the problems with an input at once.
+///
+/// @return `Result<std::vector<T>, std::vector<E>>`, every value when there were no errors, otherwise
+/// every error in order
+template <typename Iterator, typename Function>
+[[nodiscard]] auto collect_all_errors(Iterator first, Iterator last, Function &&func) -> Result<
+    std::vector<typename internal::ResultTraits<internal::mapped_result_t<Iterator, Function>>::ok_type>,
+    std::vector<typename internal::ResultTraits<internal::mapped_result_t<Iterator, Function>>::err_type>>
+{
+    using traits = internal::ResultTraits<internal::mapped_result_t<Iterator, Function>>;
+    using ValuesType = std::vector<typename traits::ok_type>;
+    using ErrorsType = std::vector<typename traits::err_type>;
+    using CollectedType = Result<ValuesType, ErrorsType>;
+
+    ValuesType values;
+    ErrorsType errors;
+    values.reserve(internal::reserve_hint(first, last));
+    for (; first != last; ++first)
+    {
+        auto result = std::invoke(func, *first);
+        if (result.is_err())
+        {
+            errors.push_back(internal::ResultAccess::err(std::move(result)));
+        }
+        else if (errors.empty())
+        {
+            values.push_back(internal::ResultAccess::ok(std::move(result)));
+        }
+    }
+    if (!errors.empty())
+    {
+        return CollectedType(std::move(errors));
+    }
+    return CollectedType(std::move(values));
+}
+
+/// @brief collect_all_errors() over a whole range.
+template <typename Range, typename Function>
+[[nodiscard]] auto collect_all_errors(Range &&range, Function &&func)
+    -> decltype(collect_all_errors(std::begin(range), std::end(range), std::forward<Function>(func)))
+{
+    return collect_all_errors(std::begin(range), std::end(range), std::forward<Function>(func));
+}
+
+#if ETL_HAS_COROUTINES
+namespace internal
+{
+/// @brief Per thread stack the frames of coroutines returning a Result are allocated from.
+///
+/// @details Such a coroutine never outlives the call that started it, it either runs to the end or stops at
+/// the first error before returning, so frames are always freed in the reverse order they were allocated in.
+/// Compilers that elide the frame never get here; everywhere else this keeps the frames off the heap. Frames
+/// that don't fit fall back to operator new.
+class CoroutineFrameStack
+{
+  private:
+    static constexpr std::size_t _capacity = 64 * 1024;
+    static constexpr std::size_t _alignment = alignof(std::max_align_t);
+
+    alignas(_alignment) std::array<std::byte, _capacity> _storage;
+    std::size_t _top{0};
+
+  public:
+    [[nodiscard]] static auto local() noexcept -> CoroutineFrameStack &
+    {
+        thread_local CoroutineFrameStack stack;
+        return stack;
+    }
+
+    [[nodiscard]] auto allocate(std::size_t size) -> void *
+    {
+        const auto rounded = (size + _alignment - 1) & ~(_alignment - 1);
+        if (rounded <= _capacity - _top)
+        {
+            void *frame = _storage.data() + _top;
+            _top += rounded;
+            return frame;
+        }
+        return ::operator new(size);
+    }
+
+    auto deallocate(void *frame, std::size_t size) noexcept -> void
+    {
+        auto *bytes = static_cast<std::byte *>(frame);
+        if (bytes >= _storage.data() && bytes < _storage.data() + _capacity)
+        {
+            _top = static_cast<std::size_t>(bytes - _storage.data());
+            return;
+        }
+        ::operator delete(frame, size);
+    }
+};
+
+template <typename OkType, typename ErrType> class ResultPromise;
+template <typename OkType, typename ErrType, typename Reference> class ResultAwaiter;
+
+/// @brief What a coroutine returning a Result hands its caller, converted to the Result once the coroutine
+/// has finished.
+template <typename OkType, typename ErrType> class ResultReturnObject
+{
+  private:
+    std::optional<Result<OkType, ErrType>> _result;
+
+  public:
+    explicit ResultReturnObject(ResultPromise<OkType, ErrType> &promise) noexcept
+    {
+        promise._result = &_result;
+    }
+
+    ~ResultReturnObject() = default;
+    ResultReturnObject(ResultReturnObject &&other) noexcept = delete;
+    auto operator=(ResultReturnObject &&other) noexcept -> ResultReturnObject & = delete;
+    ResultReturnObject(ResultReturnObject const &other) = delete;
+    auto operator=(ResultReturnObject const &other) -> ResultReturnObject & = delete;
+
+    // NOLINTNEXTLINE(google-explicit-constructor) the conversion is what the compiler calls
+    operator Result<OkType, ErrType>()
+    {
+        return std::move(*_result);
+    }
+};
+
+/// @brief Promise of a coroutine returning a Result, it runs eagerly and writes whatever the coroutine
+/// `co_return`s, or the first error it `co_await`ed, into the object returned to the caller.
+template <typename OkType, typename ErrType> class ResultPromise
+{
+  private:
+    friend class ResultReturnObject<OkType, ErrType>;
+
+    std::optional<Result<OkType, ErrType>> *_result{nullptr};
+
+  public:
+    [[nodiscard]] static auto operator new(std::size_t size) -> void *
+    {
+        return CoroutineFrameStack::local().allocate(size);
+    }
+
+    static auto operator delete(void *frame, std::size_t size) noexcept -> void
+    {
+        CoroutineFrameStack::local().deallocate(frame, size);
+    }
+
+    [[nodiscard]] auto get_return_object() noexcept -> ResultReturnObject<OkType, ErrType>
+    {
+        return ResultReturnObject<OkType, ErrType>(*this);
+    }
+
+    [[nodiscard]] static auto initial_suspend() noexcept -> std::suspend_never
+    {
+        return {};
+    }
+
+    [[nodiscard]] static auto final_suspend() noexcept -> std::suspend_never
+    {
+        return {};
+    }
+
+    /// @brief `co_return` a Result, an [OkType], or an [ErrType]
+    template <typename Value> auto return_value(Value &&value) -> void
+    {
+        _result->emplace(std::forward<Value>(value));
+    }
+
+    /// @brief Called by a `co_await`ed Result holding an error, just before the coroutine is destroyed
+    template <typename Error> auto return_error(Error &&error) -> void
+    {
+        static_assert(std::is_constructible_v<ErrType, Error &&>,
+                      "The awaited error must convert to the error type of the awaiting coroutine");
+        _result->emplace(ErrType(std::forward<Error>(error)));
+    }
+
+    [[noreturn]] static auto unhandled_exception() -> void
+    {
+        throw;
+    }
+
+    /// @brief Only Results can be awaited, they resume straight away or end the coroutine. Anything that
+    /// could suspend it, a Task for instance, is rejected: the caller reads the Result as soon as the call
+    /// returns, and the frame has to be freed in order from the stack of the thread that allocated it.
+    template <typename Ok, typename Err>
+    [[nodiscard]] auto await_transform(Result<Ok, Err> &&result) noexcept -> ResultAwaiter<Ok, Err, Result<Ok, Err> &&>
+    {
+        return ResultAwaiter<Ok, Err, Result<Ok, Err> &&>(std::move(result));
+    }
+
+    template <typename Ok, typename Err>
+    [[nodiscard]] auto await_transform(Result<Ok, Err> const &result) noexcept
+        -> ResultAwaiter<Ok, Err, Result<Ok, Err> const &>
+    {
+        return ResultAwaiter<Ok, Err, Result<Ok, Err> const &>(result);
+    }
+
+    template <typename Ok, typename Err>
+    [[nodiscard]] auto await_transform(Result<Ok, Err> &result) noexcept
+        -> ResultAwaiter<Ok, Err, Result<Ok, Err> const &>
+    {
+        return ResultAwaiter<Ok, Err, Result<Ok, Err> const &>(result);
+    }
+
+    /// @brief Return a Task instead of a Result to await anything else
+    template <typename Awaitable> auto await_transform(Awaitable &&awaitable) -> void = delete;
+};
+
+/// @brief Awaiting an ok Result resumes with its value, awaiting an error hands the error to the awaiting
+/// coroutine's promise and destroys the coroutine, which returns to its caller with that error.
+template <typename OkType, typename ErrType, typename Reference> class ResultAwaiter
+{
+  private:
+    Reference _result;
+
+  public:
+    explicit ResultAwaiter(Reference result) noexcept : _result(std::forward<Reference>(result))
+    {
+    }
+
+    [[nodiscard]] auto await_ready() const noexcept -> bool
+    {
+        return _result.is_ok();
+    }
+
+    /// @brief The awaiting coroutine returns a Result, or a Task of one
+    template <typename Promise> auto await_suspend(std::coroutine_handle<Promise> coroutine) -> void
+    {
+        coroutine.promise().return_error(*std::forward<Reference>(_result).err());
+        coroutine.destroy();
+    }
+
+    [[nodiscard]] auto await_resume() -> OkType
+    {
+        return *std::forward<Reference>(_result).ok();
+    }
+};
+} // namespace internal
+
+/// @brief Inside a coroutine returning a Result, `co_await` another Result to get its value, or to return its
+/// error straight away, much like Rust's `?` operator.
+///
+/// @details The awaiting coroutine's frame is elided by compilers that can, and otherwise comes from a per
+/// thread stack, so propagating through coroutines never touches the heap. Requires C++20.
+///
+/// @example tests/result_coroutine_test.cpp
+template <typename OkType, typename ErrType>
+[[nodiscard]] auto operator co_await(Result<OkType, ErrType> &&result) noexcept
+    -> internal::ResultAwaiter<OkType, ErrType, Result<OkType, ErrType> &&>
+{
+    return internal::ResultAwaiter<OkType, ErrType, Result<OkType, ErrType> &&>(std::move(result));
+}
+
+template <typename OkType, typename ErrType>
+[[nodiscard]] auto operator co_await(Result<OkType, ErrType> const &result) noexcept
+    -> internal::ResultAwaiter<OkType, ErrType, Result<OkType, ErrType> const &>
+{
+    return internal::ResultAwaiter<OkType, ErrType, Result<OkType, ErrType> const &>(result);
+}
+#endif
+
+class ThreadPool;
+template <typename ValueType> class Task;
+
+namespace internal
+{
+/// @brief A unit of work queued on a ThreadPool, run once and then deleted.
+class Job
+{
+  public:
+    Job() = default;
+    virtual ~Job() = default;
+    Job(Job &&other) noexcept = delete;
+    auto operator=(Job &&other) noexcept -> Job & = delete;
+    Job(Job const &other) = delete;
+    auto operator=(Job const &other) -> Job & = delete;
+
+    virtual auto run() noexcept -> void = 0;
+};
+
+template <typename Function> class FunctionJob final : public Job
+{
+  private:
+    Function _func;
+
+  public:
+    explicit FunctionJob(Function &&func) : _func(std::move(func))
+    {
+    }
+
+    explicit FunctionJob(Function const &func) : _func(func)
+    {
+    }
+
+    auto run() noexcept -> void override
+    {
+        std::invoke(_func);
+    }
+};
+
+/// @brief Chase-Lev work stealing deque with a fixed capacity.
+///
+/// @details The owning worker pushes and pops at the bottom without contention, other workers steal the
+/// oldest job from the top with a single compare and swap. Follows the C11 formulation of Lê et al.,
+/// "Correct and Efficient Work-Stealing for Weak Memory Models".
+class WorkStealingDeque
+{
+  public:
+    static constexpr std::size_t capacity = 4096;
+
+  private:
+    alignas(cache_line_size) std::atomic<int64_t> _top{0};
+    alignas(cache_line_size) std::atomic<int64_t> _bottom{0};
+    alignas(cache_line_size) std::array<std::atomic<Job *>, capacity> _jobs{};
+
+    [[nodiscard]] auto slot(int64_t index) noexcept -> std::atomic<Job *> &
+    {
+        return _jobs[static_cast<std::size_t>(index) & (capacity - 1)];
+    }
+
+  public:
+    /// @brief Owner only, false when the deque is full
+    [[nodiscard]] auto push(Job *job) noexcept -> bool
+    {
+        const auto bottom = _bottom.load(std::memory_order_relaxed);
+        const auto top = _top.load(std::memory_order_acquire);
+        if (bottom - top >= static_cast<int64_t>(capacity))
+        {
+            return false;
+        }
+        slot(bottom).store(job, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        _bottom.store(bottom + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /// @brief Owner only, takes the newest job
+    [[nodiscard]] auto pop() noexcept -> Job *
+    {
+        const auto bottom = _bottom.load(std::memory_order_relaxed) - 1;
+        _bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto top = _top.load(std::memory_order_relaxed);
+        if (top > bottom)
+        {
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        auto *job = slot(bottom).load(std::memory_order_relaxed);
+        if (top == bottom)
+        {
+            // The last job, race the thieves for it.
+            if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                job = nullptr;
+            }
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return job;
+    }
+
+    /// @brief Any thread, takes the oldest job
+    [[nodiscard]] auto steal() noexcept -> Job *
+    {
+        auto top = _top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const auto bottom = _bottom.load(std::memory_order_acquire);
+        if (top >= bottom)
+        {
+            return nullptr;
+        }
+        auto *job = slot(top).load(std::memory_order_relaxed);
+        if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            return nullptr;
+        }
+        return job;
+    }
+};
+
+/// @brief The pool, if any, the calling thread is a worker of.
+class WorkerContext
+{
+  public:
+    ThreadPool *pool{nullptr};
+    std::size_t index{0};
+};
+
+[[nodiscard]] inline auto current_worker() noexcept -> WorkerContext &
+{
+    thread_local WorkerContext context;
+    return context;
+}
+
+/// @brief What a Task and whoever completes it share: the value or the exception, once there is one, and
+/// the callbacks waiting for it.
+///
+/// @details Continuations must not throw, the ones Task and when_all() attach catch into the task they
+/// complete.
+template <typename ValueType> class TaskState
+{
+  private:
+    std::mutex _mutex;
+    std::condition_variable _readyCondition;
+    std::optional<ValueType> _value;
+    std::exception_ptr _exception;
+    std::vector<std::function<void()>> _continuations;
+    std::atomic<bool> _ready{false};
+
+    /// @brief Called once the value or exception is stored, nobody reads either before _ready is set.
+    auto publish() noexcept -> void
+    {
+        std::vector<std::function<void()>> continuations;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _ready.store(true, std::memory_order_release);
+            continuations.swap(_continuations);
+        }
+        _readyCondition.notify_all();
+        for (auto &continuation : continuations)
+        {
+            continuation();
+        }
+    }
+
+  public:
+    /// @brief Stores the value, then runs every continuation on the calling thread
+    template <typename Value> auto complete(Value &&value) -> void
+    {
+        _value.emplace(std::forward<Value>(value));
+        publish();
+    }
+
+    /// @brief Stores whatever `func` returns, or the exception it throws, then runs every continuation
+    template <typename Function> auto complete_with(Function &&func) noexcept -> void
+    {
+        try
+        {
+            _value.emplace(std::invoke(std::forward<Function>(func)));
+        }
+        catch (...)
+        {
+            _exception = std::current_exception();
+        }
+        publish();
+    }
+
+    /// @brief Stores the exception, get() rethrows it, then runs every continuation
+    auto fail(std::exception_ptr exception) noexcept -> void
+    {
+        _exception = std::move(exception);
+        publish();
+    }
+
+    /// @brief Runs `continuation` once the value is there, right away if it already is
+    auto on_ready(std::function<void()> continuation) -> void
+    {
+        if (!add_continuation(continuation))
+        {
+            continuation();
+        }
+    }
+
+    /// @brief Keeps `continuation` for later, false without taking it if the value is already there
+    [[nodiscard]] auto add_continuation(std::function<void()> &continuation) -> bool
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_ready.load(std::memory_order_relaxed))
+        {
+            return false;
+        }
+        _continuations.push_back(std::move(continuation));
+        return true;
+    }
+
+    [[nodiscard]] auto is_ready() const noexcept -> bool
+    {
+        return _ready.load(std::memory_order_acquire);
+    }
+
+    auto wait() -> void
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _readyCondition.wait(lock, [this] { return _ready.load(std::memory_order_relaxed); });
+    }
+
+    /// @brief Only once is_ready(), rethrows the exception the task failed with
+    [[nodiscard]] auto value() -> ValueType &
+    {
+        if (_exception)
+        {
+            std::rethrow_exception(_exception);
+        }
+        return *_value;
+    }
+
+    /// @brief Only once is_ready(), null unless the task failed
+    [[nodiscard]] auto exception() const noexcept -> std::exception_ptr const &
+    {
+        return _exception;
+    }
+};
+} // namespace internal
+
+/// @brief Work stealing thread pool that runs Tasks.
+///
+/// @details Every worker owns a Chase-Lev deque. Work spawned from a worker goes onto its own deque and is
+/// taken back newest first, which keeps a fan-out's data in that worker's cache, while idle workers steal
+/// the oldest jobs from the others. Work spawned from outside the pool goes through a shared queue. Workers
+/// with nothing to do sleep until more work arrives.
+///
+/// Functions run on the pool should report failure through the Result they return. An exception thrown by
+/// a spawn()ed function is stored in its Task and rethrown by get(), one thrown by a post()ed function
+/// terminates the program. The destructor runs every job still queued, then joins the workers.
+///
+/// @example tests/task_test.cpp
+class ThreadPool
+{
+  private:
+    class Worker
+    {
+      public:
+        internal::WorkStealingDeque deque;
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+
+    alignas(internal::cache_line_size) std::atomic<int64_t> _queued{0};
+    alignas(internal::cache_line_size) std::atomic<std::size_t> _sleeping{0};
+    std::atomic<bool> _stopping{false};
+
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::deque<internal::Job *> _injected;
+
+  public:
+    /// @brief Starts the workers.
+    ///
+    /// @param `threads` how many workers to start, zero means one per hardware thread
+    explicit ThreadPool(std::size_t threads = 0)
+    {
+        if (threads == 0)
+        {
+            threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+        }
+        _workers.reserve(threads);
+        for (std::size_t index = 0; index < threads; ++index)
+        {
+            _workers.push_back(std::make_unique<Worker>());
+        }
+        for (std::size_t index = 0; index < threads; ++index)
+        {
+            _workers[index]->thread = std::thread([this, index] { run(index); });
+        }
+    }
+
+    /// @brief Runs every queued job, then joins the workers
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping.store(true, std::memory_order_seq_cst);
+        }
+        _wake.notify_all();
+        for (auto &worker : _workers)
+        {
+            worker->thread.join();
+        }
+    }
+
+    ThreadPool(ThreadPool &&other) noexcept = delete;
+    auto operator=(ThreadPool &&other) noexcept -> ThreadPool & = delete;
+    ThreadPool(ThreadPool const &other) = delete;
+    auto operator=(ThreadPool const &other) -> ThreadPool & = delete;
+
+  public:
+    /// @brief Get the number of workers
+    [[nodiscard]] auto size() const noexcept -> std::size_t
+    {
+        return _workers.size();
+    }
+
+    /// @brief Runs `func` on the pool, nothing is returned, so `func` must not throw
+    template <typename Function> auto post(Function &&func) -> void
+    {
+        enqueue(new internal::FunctionJob<std::decay_t<Function>>(std::forward<Function>(func)));
+    }
+
+    /// @brief Runs `func` on the pool
+    ///
+    /// @return A Task completed with whatever `func` returns, typically a Result, or with what it throws
+    template <typename Function>
+    [[nodiscard]] auto spawn(Function &&func) -> Task<std::invoke_result_t<std::decay_t<Function> &>>
+    {
+        using ValueType = std::invoke_result_t<std::decay_t<Function> &>;
+        auto state = std::make_shared<internal::TaskState<ValueType>>();
+        post([state, func = std::forward<Function>(func)]() mutable { state->complete_with(func); });
+        return Task<ValueType>(std::move(state));
+    }
+
+    /// @brief Called from a worker of this pool, runs one queued job if there is one.
+    ///
+    /// @details Lets a worker waiting on a Task keep the pool busy instead of blocking it.
+    auto run_one() -> bool
+    {
+        auto const &context = internal::current_worker();
+        if (context.pool != this)
+        {
+            return false;
+        }
+        if (auto *job = find(context.index); job != nullptr)
+        {
+            execute(job);
+            return true;
+        }
+        return false;
+    }
+
+  private:
+    auto enqueue(internal::Job *job) -> void
+    {
+        auto const &context = internal::current_worker();
+        if (context.pool != this || !_workers[context.index]->deque.push(job))
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _injected.push_back(job);
+        }
+        // Pairs with the sleeping worker, which announces itself before checking _queued.
+        _queued.fetch_add(1, std::memory_order_seq_cst);
+        if (_sleeping.load(std::memory_order_seq_cst) > 0)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _wake.notify_one();
+        }
+    }
+
+    /// @brief Own deque first, then the shared queue, then the other workers' deques.
+    [[nodiscard]] auto find(std::size_t index) -> internal::Job *
+    {
+        auto *job = _workers[index]->deque.pop();
+        if (job == nullptr)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_injected.empty())
+            {
+                job = _injected.front();
+                _injected.pop_front();
+            }
+        }
+        for (std::size_t offset = 1; job == nullptr && offset < _workers.size(); ++offset)
+        {
+            job = _workers[(index + offset) % _workers.size()]->deque.steal();
+        }
+        if (job != nullptr)
+        {
+            _queued.fetch_sub(1, std::memory_order_relaxed);
+        }
+        return job;
+    }
+
+    static auto execute(internal::Job *job) noexcept -> void
+    {
+        job->run();
+        delete job;
+    }
+
+    auto run(std::size_t index) -> void
+    {
+        internal::current_worker() = internal::WorkerContext{this, index};
+        while (true)
+        {
+            if (auto *job = find(index); job != nullptr)
+            {
+                execute(job);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(_mutex);
+            _sleeping.fetch_add(1, std::memory_order_seq_cst);
+            _wake.wait(lock, [this] {
+                return _stopping.load(std::memory_order_relaxed) || _queued.load(std::memory_order_seq_cst) > 0;
+            });
+            _sleeping.fetch_sub(1, std::memory_order_relaxed);
+            if (_stopping.load(std::memory_order_relaxed) && _queued.load(std::memory_order_seq_cst) <= 0)
+            {
+                return;
+            }
+        }
+    }
+};
+
+/// @brief The eventual value of work running on a ThreadPool, usually a Result.
+///
+/// @details A Task is a shared handle, copies refer to the same value. Wait for it with get(), or chain
+/// work onto it with then(), which runs on whichever thread completes the task. A task whose function threw
+/// holds the exception instead, get() rethrows it and then() passes it on without running its function.
+/// Waiting from a worker of a pool runs other queued jobs in the meantime, so nested fan-outs don't deadlock
+/// the pool. With C++20, coroutines returning a Task can `co_await` other tasks.
+///
+/// @example tests/task_test.cpp
+template <typename ValueType> class Task
+{
+  private:
+    std::shared_ptr<internal::TaskState<ValueType>> _state;
+
+  public:
+    explicit Task(std::shared_ptr<internal::TaskState<ValueType>> state) noexcept : _state(std::move(state))
+    {
+    }
+
+  public:
+    /// @brief Check if the value is there, without waiting
+    [[nodiscard]] auto is_ready() const noexcept -> bool
+    {
+        return _state->is_ready();
+    }
+
+    /// @brief Waits for the value, running other jobs meanwhile when called from a pool worker
+    auto wait() const -> void
+    {
+        if (auto *pool = internal::current_worker().pool; pool != nullptr)
+        {
+            while (!is_ready())
+            {
+                if (!pool->run_one())
+                {
+                    std::this_thread::yield();
+                }
+            }
+            return;
+        }
+        _state->wait();
+    }
+
+    /// @brief Waits for the value and returns it, or rethrows the exception the task failed with
+    [[nodiscard]] auto get() const -> ValueType const &
+    {
+        wait();
+        return _state->value();
+    }
+
+    /// @brief Runs `func` with the value once it is there, on the thread that completes this task.
+    ///
+    /// @return A Task completed with whatever `func` returns, or with the exception `func` or this task threw
+    template <typename Function>
+    [[nodiscard]] auto then(Function &&func) const
+        -> Task<std::invoke_result_t<std::decay_t<Function> &, ValueType const &>>
+    {
+        using NextType = std::invoke_result_t<std::decay_t<Function> &, ValueType const &>;
+        auto next = std::make_shared<internal::TaskState<NextType>>();
+        _state->on_ready([state = _state, next, func = std::forward<Function>(func)]() mutable {
+            if (state->exception())
+            {
+                next->fail(state->exception());
+                return;
+            }
+            next->complete_with([&] { return std::invoke(func, std::as_const(state->value())); });
+        });
+        return Task<NextType>(std::move(next));
+    }
+
+    /// @brief Get the state shared by copies of this task
+    [[nodiscard]] auto state() const noexcept -> std::shared_ptr<internal::TaskState<ValueType>> const &
+    {
+        return _state;
+    }
+};
+
+/// @brief A task completed with the value of every task in `tasks`, in the same order, once they all are.
+///
+/// @details For tasks of Results this collects every Result, ok or not, so the caller sees each failure.
+/// If a task threw, the first such task in `tasks` passes its exception on instead.
+template <typename ValueType>
+[[nodiscard]] auto when_all(std::vector<Task<ValueType>> tasks) -> Task<std::vector<ValueType>>
+{
+    auto all = std::make_shared<internal::TaskState<std::vector<ValueType>>>();
+    if (tasks.empty())
+    {
+        all->complete(std::vector<ValueType>());
+        return Task<std::vector<ValueType>>(std::move(all));
+    }
+    auto remaining = std::make_shared<std::atomic<std::size_t>>(tasks.size());
+    auto shared = std::make_shared<std::vector<Task<ValueType>>>(std::move(tasks));
+    for (auto const &task : *shared)
+    {
+        task.state()->on_ready([all, remaining, shared] {
+            if (remaining->fetch_sub(1, std::memory_order_acq_rel) != 1)
+            {
+                return;
+            }
+            all->complete_with([&shared] {
+                std::vector<ValueType> values;
+                values.reserve(shared->size());
+                for (auto const &done : *shared)
+                {
+                    values.push_back(done.state()->value());
+                }
+                return values;
+            });
+        });
+    }
+    return Task<std::vector<ValueType>>(std::move(all));
+}
+
+/// @brief Which task of a when_any() finished first, and its value.
+template <typename ValueType> class WhenAny
+{
+  public:
+    std::size_t index{0};
+    ValueType value;
+};
+
+/// @brief A task completed with the first of `tasks` to complete, or with its exception if it threw.
+///
+/// @details `tasks` must not be empty, the task returned would never complete.
+template <typename ValueType>
+[[nodiscard]] auto when_any(std::vector<Task<ValueType>> const &tasks) -> Task<WhenAny<ValueType>>
+{
+    assert(!tasks.empty() && "when_any() of no tasks never completes");
+    auto any = std::make_shared<internal::TaskState<WhenAny<ValueType>>>();
+    auto claimed = std::make_shared<std::atomic<bool>>(false);
+    for (std::size_t index = 0; index < tasks.size(); ++index)
+    {
+        tasks[index].state()->on_ready([any, claimed, index, state = tasks[index].state()] {
+            if (!claimed->exchange(true, std::memory_order_acq_rel))
+            {
+                any->complete_with([&] { return WhenAny<ValueType>{index, state->value()}; });
+            }
+        });
+    }
+    return Task<WhenAny<ValueType>>(std::move(any));
+}
+
+#if ETL_HAS_COROUTINES
+namespace internal
+{
+/// @brief Promise of a coroutine returning a Task. It starts on the calling thread, and wherever it
+/// resumes after a `co_await`, its frame lives on the heap until it finishes.
+template <typename ValueType> class TaskPromise
+{
+  private:
+    std::shared_ptr<TaskState<ValueType>> _state = std::make_shared<TaskState<ValueType>>();
+
+  public:
+    [[nodiscard]] auto get_return_object() -> Task<ValueType>
+    {
+        return Task<ValueType>(_state);
+    }
+
+    [[nodiscard]] static auto initial_suspend() noexcept -> std::suspend_never
+    {
+        return {};
+    }
+
+    [[nodiscard]] static auto final_suspend() noexcept -> std::suspend_never
+    {
+        return {};
+    }
+
+    template <typename Value> auto return_value(Value &&value) -> void
+    {
+        _state->complete(ValueType(std::forward<Value>(value)));
+    }
+
+    /// @brief A `co_await`ed Result held an error, the task completes with it
+    template <typename Error> auto return_error(Error &&error) -> void
+    {
+        _state->complete(ValueType(std::forward<Error>(error)));
+    }
+
+    /// @brief The task completes with the exception, awaiting it or calling get() rethrows it
+    auto unhandled_exception() noexcept -> void
+    {
+        _state->fail(std::current_exception());
+    }
+};
+
+/// @brief Resumes the awaiting coroutine on the thread that completes the task. Only coroutines returning
+/// a Task can await one, they are the ones whose frame can be resumed on another thread.
+template <typename ValueType> class TaskAwaiter
+{
+  private:
+    std::shared_ptr<TaskState<ValueType>> _state;
+
+  public:
+    explicit TaskAwaiter(std::shared_ptr<TaskState<ValueType>> state) noexcept : _state(std::move(state))
+    {
+    }
+
+    [[nodiscard]] auto await_ready() const noexcept -> bool
+    {
+        return _state->is_ready();
+    }
+
+    template <typename AwaitingType>
+    [[nodiscard]] auto await_suspend(std::coroutine_handle<TaskPromise<AwaitingType>> coroutine) -> bool
+    {
+        std::function<void()> resume = [coroutine] { coroutine.resume(); };
+        return _state->add_continuation(resume);
+    }
+
+    [[nodiscard]] auto await_resume() -> ValueType
+    {
+        return _state->value();
+    }
+};
+
+/// @brief Moves the awaiting coroutine, which has to return a Task, onto a worker of the pool.
+class ScheduleAwaiter
+{
+  private:
+    ThreadPool *_pool;
+
+  public:
+    explicit ScheduleAwaiter(ThreadPool &pool) noexcept : _pool(&pool)
+    {
+    }
+
+    [[nodiscard]] static auto await_ready() noexcept -> bool
+    {
+        return false;
+    }
+
+    template <typename AwaitingType>
+    auto await_suspend(std::coroutine_handle<TaskPromise<AwaitingType>> coroutine) -> void
+    {
+        _pool->post([coroutine] { coroutine.resume(); });
+    }
+
+    static auto await_resume() noexcept -> void
+    {
+    }
+};
+} // namespace internal
+
+/// @brief Inside a coroutine, waits for the task without blocking a thread and resumes with its value.
+template <typename ValueType>
+[[nodiscard]] auto operator co_await(Task<ValueType> const &task) noexcept -> internal::TaskAwaiter<ValueType>
+{
+    return internal::TaskAwaiter<ValueType>(task.state());
+}
+
+/// @brief `co_await schedule(pool)` continues the coroutine on one of the pool's workers.
+[[nodiscard]] inline auto schedule(ThreadPool &pool) noexcept -> internal::ScheduleAwaiter
+{
+    return internal::ScheduleAwaiter(pool);
+}
+#endif
+
+/// @brief Jump table dispatch from the values of a contiguous enumeration to handler functions.
+///
+/// @details Uses the same [beginValue, endValue] bounds as the EnumerationIterator to build a flat array
+/// of function pointers, one slot per enumerator. Dispatching is a single bounds check followed by one
+/// indirect call, regardless of how many enumerators there are. Values outside of the range, or slots which
+/// were never bound, return an Error rather than invoking undefined behaviour.
+///
+/// @example tests/enum_dispatch_test.cpp
+template <typename EnumType, EnumType beginValue, EnumType endValue, typename Signature> class EnumDispatch;
+
+template <typename EnumType, EnumType beginValue, EnumType endValue, typename ReturnType, typename... Args>
+class EnumDispatch<EnumType, beginValue, endValue, ReturnType(Args...)>
+{
+  public:
+    using Handler = ReturnType (*)(Args...);
+
+    /// @brief Handlers returning void are reported as Result<Void, Error>
+    using OkType = std::conditional_t<std::is_void_v<ReturnType>, Void, ReturnType>;
+
+  private:
+    static constexpr std::size_t _size = EnumerationIterator<EnumType, beginValue, endValue>::size();
+
+    std::array<Handler, _size> _table{};
+
+  private:
+    /// @brief Maps an enumerator to its slot in the table.
+    [[nodiscard]] static constexpr auto index(EnumType value) noexcept -> std::size_t
+    {
+        return internal::enum_offset(value, beginValue);
+    }
+
+    template <template <EnumType> class HandlerTemplate, std::size_t... Indices>
+    [[nodiscard]] static constexpr auto create(std::index_sequence<Indices...> /*unused*/) noexcept -> EnumDispatch
+    {
+        using value_t = std::underlying_type_t<EnumType>;
+
+        EnumDispatch dispatcher;
+        ((dispatcher._table[Indices] = &HandlerTemplate<static_cast<EnumType>(static_cast<value_t>(
+              static_cast<std::int64_t>(beginValue) + static_cast<std::int64_t>(Indices)))>::call),
+         ...);
+        return dispatcher;
+    }
+
+  public:
+    /// @brief Builds an empty table, every enumerator must be bound before it can be dispatched.
+    constexpr EnumDispatch() noexcept = default;
+
+    /// @brief Builds a fully populated table at compile time from a handler class template.
+    ///
+    /// @details HandlerTemplate<E::X>::call is bound to the slot of every enumerator E::X in the range,
+    /// so a switch statement can be replaced by a specialization per enumerator.
+    template <template <EnumType> class HandlerTemplate>
+    [[nodiscard]] static constexpr auto create() noexcept -> EnumDispatch
+    {
+        return create<HandlerTemplate>(std::make_index_sequence<_size>{});
+    }
+
+  public:
+    /// @brief The number of enumerators in the range, and therefore the number of slots in the table.
+    [[nodiscard]] static constexpr auto size() noexcept -> std::size_t
+    {
+        return _size;
+    }
+
+    /// @brief Bind a handler to an enumerator, values outside of the range are ignored.
+    ///
+    /// @return A reference to itself so bindings can be chained.
+    constexpr auto bind(EnumType value, Handler handler) noexcept -> EnumDispatch &
+    {
+        if (const auto idx = index(value); idx < _size)
+        {
+            _table[idx] = handler;
+        }
+        return *this;
+    }
+
+    /// @brief Check if an enumerator is in range and has a handler bound to it.
+    [[nodiscard]] constexpr auto is_bound(EnumType value) const noexcept -> bool
+    {
+        const auto idx = index(value);
+        return idx < _size && _table[idx] != nullptr;
+    }
+
+    /// @brief Invokes the handler bound to the enumerator with the given arguments.
+    ///
+    /// @return Result<OkType, Error> holding the handlers return value, or an Error if the value
+    /// is out of range or no handler has been bound to it.
+    [[nodiscard]] auto dispatch(EnumType value, Args... args) const -> Result<OkType, Error>
+    {
+        const auto idx = index(value);
+        if (idx >= _size || _table[idx] == nullptr)
+        {
+            return Result<OkType, Error>(Error::create("No handler bound to enumeration value", RUNTIME_INFO));
+        }
+
+        if constexpr (std::is_void_v<ReturnType>)
+        {
+            _table[idx](std::forward<Args>(args)...);
+            return Result<OkType, Error>(Void{});
+        }
+        else
+        {
+            return Result<OkType, Error>(_table[idx](std::forward<Args>(args)...));
+        }
+    }
+};
+
+/// @brief A non owning view of a contiguous sequence, a minimal stand in for C++20's std::span.
+///
+/// @example tests/result_test.cpp
+template <typename T> class Span
+{
+  private:
+    T *_data{nullptr};
+    std::size_t _size{0};
+
+  public:
+    constexpr Span() noexcept = default;
+    constexpr Span(T *data, std::size_t size) noexcept : _data(data), _size(size)
+    {
+    }
+
+    /// @brief Views any contiguous container with data() and size(), std::array, std::vector and the like
+    template <typename Container,
+              typename = std::enable_if_t<std::is_convertible_v<decltype(std::declval<Container &>().data()), T *>>>
+    constexpr Span(Container &container) noexcept : _data(container.data()), _size(container.size())
+    {
+    }
+
+    /// @brief A view of mutable elements converts to a view of const ones
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    constexpr Span(Span<U> const &other) noexcept : _data(other.data()), _size(other.size())
+    {
+    }
+
+  public:
+    [[nodiscard]] constexpr auto data() const noexcept -> T *
+    {
+        return _data;
+    }
+
+    [[nodiscard]] constexpr auto size() const noexcept -> std::size_t
+    {
+        return _size;
+    }
+
+    [[nodiscard]] constexpr auto empty() const noexcept -> bool
+    {
+        return _size == 0;
+    }
+
+    [[nodiscard]] constexpr auto begin() const noexcept -> T *
+    {
+        return _data;
+    }
+
+    [[nodiscard]] constexpr auto end() const noexcept -> T *
+    {
+        return _data + _size;
+    }
+
+    [[nodiscard]] constexpr auto operator[](std::size_t index) const noexcept -> T &
+    {
+        return _data[index];
+    }
+
+    /// @brief The `count` elements starting at `offset`, or everything after it, clamped to the view
+    [[nodiscard]] constexpr auto subspan(std::size_t offset,
+                                         std::size_t count = static_cast<std::size_t>(-1)) const noexcept -> Span
+    {
+        offset = std::min(offset, _size);
+        return Span(_data + offset, std::min(count, _size - offset));
+    }
+};
+
+namespace internal
+{
+/// @brief Appends fixed size values and byte strings to a buffer, counting what does not fit rather
+/// than writing it, so a failed write still knows how big the buffer had to be.
+class ByteWriter
+{
+  private:
+    Span<std::byte> _out;
+    std::size_t _pos{0};
+    bool _tooLong{false};
+
+  public:
+    explicit ByteWriter(Span<std::byte> out) noexcept : _out(out)
+    {
+    }
+
+    template <typename T> auto put(T const &value) noexcept -> void
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values are written as bytes");
+        putBytes(&value, sizeof(T));
+    }
+
+    auto putBytes(void const *bytes, std::size_t count) noexcept -> void
+    {
+        if (count > 0 && _pos + count <= _out.size())
+        {
+            std::memcpy(_out.data() + _pos, bytes, count);
+        }
+        _pos += count;
+    }
+
+    /// @brief A 32 bit length or count, anything larger can't be encoded and fails the writer.
+    auto putLength(std::size_t length) noexcept -> void
+    {
+        if (length > std::numeric_limits<uint32_t>::max())
+        {
+            _tooLong = true;
+        }
+        put(static_cast<uint32_t>(length));
+    }
+
+    /// @brief A length prefixed string, strings of 4 GiB or more fail the writer rather than being cut short.
+    auto putString(std::string_view const &text) noexcept -> void
+    {
+        putLength(text.size());
+        if (!_tooLong)
+        {
+            putBytes(text.data(), text.size());
+        }
+    }
+
+    [[nodiscard]] auto size() const noexcept -> std::size_t
+    {
+        return _pos;
+    }
+
+    [[nodiscard]] auto fits() const noexcept -> bool
+    {
+        return _pos <= _out.size();
+    }
+
+    /// @brief False once a length didn't fit the 32 bit prefix, what was written is then unusable.
+    [[nodiscard]] auto encodable() const noexcept -> bool
+    {
+        return !_tooLong;
+    }
+};
+
+/// @brief Reads back what ByteWriter wrote, strings come back as views into the buffer. Any read past the
+/// end fails the reader, and every later read returns nothing.
+class ByteReader
+{
+  private:
+    Span<std::byte const> _in;
+    std::size_t _pos{0};
+    bool _failed{false};
+
+  public:
+    explicit ByteReader(Span<std::byte const> in) noexcept : _in(in)
+    {
+    }
+
+    template <typename T> [[nodiscard]] auto get() noexcept -> T
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values are read from bytes");
+        T value{};
+        if (auto const *bytes = take(sizeof(T)); bytes != nullptr)
+        {
+            std::memcpy(&value, bytes, sizeof(T));
+        }
+        return value;
+    }
+
+    [[nodiscard]] auto getString() noexcept -> std::string_view
+    {
+        const auto length = get<uint32_t>();
+        auto const *bytes = take(length);
+        return bytes == nullptr ? std::string_view() : std::string_view(reinterpret_cast<char const *>(bytes), length);
+    }
+
+    /// @brief Views the next `count` bytes and moves past them, null if there aren't that many
+    [[nodiscard]] auto take(std::size_t count) noexcept -> std::byte const *
+    {
+        if (_failed || count > _in.size() - _pos)
+        {
+            _failed = true;
+            return nullptr;
+        }
+        auto const *bytes = _in.data() + _pos;
+        _pos += count;
+        return bytes;
+    }
+
+    [[nodiscard]] auto failed() const noexcept -> bool
+    {
+        return _failed;
+    }
+
+    /// @brief True once every byte has been read without failing
+    [[nodiscard]] auto exhausted() const noexcept -> bool
+    {
+        return !_failed && _pos == _in.size();
+    }
+};
+
+/// @brief Leading byte of every encoded record, so decoding the wrong kind of record fails cleanly.
+enum class RecordKind : uint8_t
+{
+    Error = 0x45,
+    Result = 0x52,
+};
+
+/// @brief A presence byte, then the line, file and function of the location if there is one.
+inline auto encode_location(ByteWriter &writer, std::optional<SourceCodeLocation> const &location) noexcept -> void
+{
+    writer.put(static_cast<uint8_t>(location.has_value()));
+    if (location.has_value())
+    {
+        writer.put(location->line());
+        writer.putString(location->file());
+        writer.putString(location->function());
+    }
+}
+
+/// @brief Reads back what encode_location() wrote, the location views the reader's buffer.
+[[nodiscard]] inline auto decode_location(ByteReader &reader) noexcept -> std::optional<SourceCodeLocation>
+{
+    if (reader.get<uint8_t>() == 0)
+    {
+        return std::nullopt;
+    }
+    const auto line = reader.get<uint32_t>();
+    const auto file = reader.getString();
+    const auto function = reader.getString();
+    return SourceCodeLocation(borrowed_strings, file, line, function);
+}
+} // namespace internal
+
+/// @brief A decoded error, viewing the buffer it was decoded from without copying any of it.
+///
+/// @details Returned by etl::deserialize for errors. Every string it hands out, source location
+/// included, points into that buffer, which has to outlive the view and everything taken from it.
+class ErrorView : public IError
+{
+  private:
+    /// @brief A context frame as decoded, both of its parts view the buffer.
+    class ContextFrame
+    {
+      public:
+        std::string_view message;
+        std::optional<SourceCodeLocation> location;
+    };
+
+    std::string_view _msg;
+    int32_t _code{0};
+    std::optional<SourceCodeLocation> _location;
+    std::vector<ContextFrame> _contexts;
+
+  public:
+    ErrorView() noexcept = default;
+
+    /// @brief Default Destructor, Move/Copy constructor and assignment
+    ~ErrorView() override = default;
+    ErrorView(ErrorView &&other) noexcept = default;
+    auto operator=(ErrorView &&other) noexcept -> ErrorView & = default;
+    ErrorView(ErrorView const &other) = default;
+    auto operator=(ErrorView const &other) -> ErrorView & = default;
+
+  public:
+    /// @brief Get the error message without copying it
+    [[nodiscard]] inline auto view() const noexcept -> std::string_view
+    {
+        return _msg;
+    }
+
+    /// @brief Get the error code, zero for errors that don't have one
+    [[nodiscard]] inline auto code() const noexcept -> int32_t
+    {
+        return _code;
+    }
+
+    /// @brief Get the source location the error was created at, if it had one
+    [[nodiscard]] inline auto location() const noexcept -> std::optional<SourceCodeLocation> const &
+    {
+        return _location;
+    }
+
+    [[nodiscard]] inline auto context_count() const noexcept -> std::size_t
+    {
+        return _contexts.size();
+    }
+
+    /// @brief Get the message of a context frame, frames are numbered in the order they were attached
+    [[nodiscard]] inline auto context_message(std::size_t index) const noexcept -> std::string_view
+    {
+        return _contexts[index].message;
+    }
+
+    /// @brief Get the source location of a context frame, if it was attached with one
+    [[nodiscard]] inline auto context_location(std::size_t index) const noexcept
+        -> std::optional<SourceCodeLocation> const &
+    {
+        return _contexts[index].location;
+    }
+
+    [[nodiscard]] inline auto msg() const noexcept -> std::string override
+    {
+        return std::string(_msg);
+    }
+
+    /// @brief Formats the error the same way as the Error it was encoded from
+    [[nodiscard]] inline auto info() const noexcept -> std::string override
+    {
+        if (!_location.has_value() && _contexts.empty())
+        {
+            return msg();
+        }
+        std::string info;
+        info.append("Error: ").append(_msg);
+        internal::append_location(info, _location, "");
+        for (auto const &frame : _contexts)
+        {
+            info.append("\nContext: ").append(frame.message);
+            internal::append_location(info, frame.location, "  ");
+        }
+        return info;
+    }
+
+    /// @brief Decodes an error written by etl::serialize_into, the reader fails if the bytes are malformed.
+    ///
+    /// @details Every context frame is decoded here, once, and the record is rejected unless exactly the
+    /// number of frames it claims use up exactly the context bytes it claims.
+    [[nodiscard]] static auto decode(internal::ByteReader &reader) noexcept -> ErrorView
+    {
+        ErrorView error;
+        if (reader.get<internal::RecordKind>() != internal::RecordKind::Error)
+        {
+            static_cast<void>(reader.take(static_cast<std::size_t>(-1)));
+            return error;
+        }
+        error._code = reader.get<int32_t>();
+        error._msg = reader.getString();
+        error._location = internal::decode_location(reader);
+        const auto contextCount = reader.get<uint32_t>();
+        const auto contextBytes = reader.get<uint32_t>();
+        auto const *contexts = reader.take(contextBytes);
+        if (contexts == nullptr)
+        {
+            return error;
+        }
+
+        // The count is not trusted for sizing anything, frames are read until the bytes run out.
+        internal::ByteReader frames(Span<std::byte const>(contexts, contextBytes));
+        while (error._contexts.size() < contextCount && !frames.exhausted())
+        {
+            const auto message = frames.getString();
+            auto location = internal::decode_location(frames);
+            if (frames.failed())
+            {
+                break;
+            }
+            error._contexts.push_back(ContextFrame{message, std::move(location)});
+        }
+        if (error._contexts.size() != contextCount || !frames.exhausted())
+        {
+            static_cast<void>(reader.take(static_cast<std::size_t>(-1)));
+        }
+        return error;
+    }
+};
+
+namespace internal
+{
+/// @brief Writes the fields every error encoding shares, the context frames are written by the caller.
+inline auto encode_error_header(ByteWriter &writer, std::string_view const &msg, int32_t code,
+                                std::optional<SourceCodeLocation> const &location) noexcept -> void
+{
+    writer.put(RecordKind::Error);
+    writer.put(code);
+    writer.putString(msg);
+    encode_location(writer, location);
+}
+
+/// @brief How each serializable type is written, and what it is read back as.
+template <typename T> struct Serial;
+
+template <typename Allocator> struct Serial<BasicError<Allocator>>
+{
+    using view_type = ErrorView;
+
+    static auto encode(ByteWriter &writer, BasicError<Allocator> const &error) noexcept -> void
+    {
+        encode_error_header(writer, error.view(), 0, error.location());
+        writer.putLength(error.context_count());
+        ByteWriter sizing{Span<std::byte>()};
+        encodeContexts(sizing, error);
+        writer.putLength(sizing.size());
+        encodeContexts(writer, error);
+    }
+
+    static auto encodeContexts(ByteWriter &writer, BasicError<Allocator> const &error) noexcept -> void
+    {
+        for (std::size_t index = 0; index < error.context_count(); ++index)
+        {
+            writer.putString(error.context_message(index));
+            encode_location(writer, error.context_location(index));
+        }
+    }
+
+    static auto decode(ByteReader &reader) noexcept -> view_type
+    {
+        return ErrorView::decode(reader);
+    }
+};
+
+template <> struct Serial<StaticError>
+{
+    using view_type = ErrorView;
+
+    static auto encode(ByteWriter &writer, StaticError const &error) noexcept -> void
+    {
+        encode_error_header(writer, error.view(), error.code(), std::nullopt);
+        writer.put(uint32_t{0});
+        writer.put(uint32_t{0});
+    }
+
+    static auto decode(ByteReader &reader) noexcept -> view_type
+    {
+        return ErrorView::decode(reader);
+    }
+};
+
+/// @brief Ok payloads are copied byte for byte, so only trivially copyable ones are supported.
+template <typename OkType, typename ErrType> struct Serial<Result<OkType, ErrType>>
+{
+    static_assert(std::is_trivially_copyable_v<OkType>, "Only results with trivially copyable Ok types serialize");
+
+    using view_type = Result<OkType, typename Serial<ErrType>::view_type>;
+
+    static auto encode(ByteWriter &writer, Result<OkType, ErrType> const &result) -> void
+    {
+        writer.put(RecordKind::Result);
+        writer.put(static_cast<uint8_t>(result.is_ok()));
+        if (result.is_ok())
+        {
+            writer.put(static_cast<uint32_t>(sizeof(OkType)));
+            writer.put(result.ok().value());
+        }
+        else
+        {
+            Serial<ErrType>::encode(writer, result.err().value());
+        }
+    }
+
+    static auto decode(ByteReader &reader) noexcept -> view_type
+    {
+        if (reader.get<RecordKind>() != RecordKind::Result)
+        {
+            static_cast<void>(reader.take(static_cast<std::size_t>(-1)));
+            return view_type();
+        }
+        if (reader.get<uint8_t>() == 0)
+        {
+            return view_type(Serial<ErrType>::decode(reader));
+        }
+        if (reader.get<uint32_t>() != sizeof(OkType))
+        {
+            static_cast<void>(reader.take(static_cast<std::size_t>(-1)));
+            return view_type();
+        }
+        return view_type(reader.get<OkType>());
+    }
+};
+} // namespace internal
+
+/// @brief The number of bytes serialize_into() needs for `value`.
+template <typename T> [[nodiscard]] auto serialized_size(T const &value) -> std::size_t
+{
+    internal::ByteWriter writer{Span<std::byte>()};
+    internal::Serial<T>::encode(writer, value);
+    return writer.size();
+}
+
+/// @brief Encodes an Error, a StaticError, or a Result of a trivially copyable type and one of those,
+/// into `out`.
+///
+/// @details The encoding is compact and native endian, meant for processes on the same machine talking
+/// over pipes or shared memory. Read it back with etl::deserialize.
+///
+/// @return The number of bytes written, or an error when `out` is too small or a string is 4 GiB or longer.
+template <typename T>
+[[nodiscard]] auto serialize_into(T const &value, Span<std::byte> out) -> Result<std::size_t, Error>
+{
+    internal::ByteWriter writer(out);
+    internal::Serial<T>::encode(writer, value);
+    if (!writer.encodable())
+    {
+        return Result<std::size_t, Error>(Error::create("String too long to serialize", RUNTIME_INFO));
+    }
+    if (!writer.fits())
+    {
+        return Result<std::size_t, Error>(Error::create("Buffer too small to serialize into", RUNTIME_INFO));
+    }
+    return Result<std::size_t, Error>(writer.size());
+}
+
+/// @brief Decodes what serialize_into() wrote for a `T`, without copying strings out of `in`.
+///
+/// @details Errors come back as ErrorViews, which point into `in`, and results as
+/// `Result<OkType, ErrorView>`. Truncated or malformed input is reported as an error.
+template <typename T>
+[[nodiscard]] auto deserialize(Span<std::byte const> in) -> Result<typename internal::Serial<T>::view_type, Error>
+{
+    using view_type = typename internal::Serial<T>::view_type;
+    internal::ByteReader reader(in);
+    auto view = internal::Serial<T>::decode(reader);
+    if (reader.failed())
+    {
+        return Result<view_type, Error>(Error::create("Malformed or truncated serialized record", RUNTIME_INFO));
+    }
+    return Result<view_type, Error>(std::move(view));
+}
+
+/// @brief An error from a bulk operation, with the position of the input it came from.
+template <typename ErrType> class IndexedError
+{
+  public:
+    std::size_t index{0};
+    ErrType error;
+};
+
+/// @brief What transform_results() found: every error in input order, and how many errors each chunk had.
+template <typename ErrType> class TransformReport
+{
+  public:
+    /// @brief Inputs per chunk, chunk `i` covers [i * chunk_size, (i + 1) * chunk_size)
+    std::size_t chunk_size{0};
+    std::vector<std::size_t> chunk_errors;
+    std::vector<IndexedError<ErrType>> errors;
+
+    [[nodiscard]] auto ok() const noexcept -> bool
+    {
+        return errors.empty();
+    }
+
+    [[nodiscard]] auto error_count() const noexcept -> std::size_t
+    {
+        return errors.size();
+    }
+};
+
+namespace internal
+{
+/// @brief Enough chunks to keep every worker busy while the slow ones catch up, each at least a few
+/// thousand elements so queueing a chunk costs next to nothing, rounded so a chunk of output spans a
+/// whole number of cache lines.
+template <typename OkType>
+[[nodiscard]] auto transform_chunk_size(std::size_t count, std::size_t workers) noexcept -> std::size_t
+{
+    constexpr std::size_t min_chunk = 4096;
+    constexpr std::size_t line = cache_line_size / std::gcd(cache_line_size, sizeof(OkType));
+    const auto target = std::max(min_chunk, count / (workers * 8));
+    return (target + line - 1) / line * line;
+}
+} // namespace internal
+
+/// @brief Runs `func` over every element of `input` on `pool`, in chunks, writing each Ok value to the
+/// same position in `output`.
+///
+/// @details `func` takes an element and returns a `Result<T, E>`. Every chunk writes its values straight into `output`,
+/// and keeps its errors to itself, so the workers never share a lock. `output` has to be at least as large as `input`,
+/// which is asserted; without assertions a shorter `output` is never written past. When `chunk_size` is zero the picked
+/// size spans whole cache lines of output, so if `output.data()` also starts on a cache line no two chunks write to the
+/// same line; otherwise neighbouring chunks may share the one line their boundary falls in. Positions whose element
+/// failed are left untouched. Waits for every chunk, running chunks itself when called from a worker of `pool`.
+///
+/// If `func` throws, chunks that have not started yet are skipped, and once every chunk is done the first
+/// exception is rethrown. If posting a chunk throws, the chunks already posted are waited for first.
+///
+/// @param `chunk_size` inputs per chunk, zero picks one from the input size and the number of workers
+///
+/// @return Every error with the index of its input, and the number of errors per chunk
+///
+/// @example tests/task_test.cpp
+template <typename Input, typename OkType, typename Function>
+[[nodiscard]] auto transform_results(ThreadPool &pool, Span<Input> input, Span<OkType> output, Function &&func,
+                                     std::size_t chunk_size = 0)
+    -> TransformReport<typename internal::ResultTraits<internal::mapped_result_t<Input *, Function>>::err_type>
+{
+    using ErrType = typename internal::ResultTraits<internal::mapped_result_t<Input *, Function>>::err_type;
+    using ChunkErrors = std::vector<IndexedError<ErrType>>;
+
+    assert(output.size() >= input.size() && "transform_results() needs an output slot for every input");
+
+    TransformReport<ErrType> report;
+    const auto count = std::min(input.size(), output.size());
+    report.chunk_size = chunk_size == 0 ? internal::transform_chunk_size<OkType>(count, pool.size()) : chunk_size;
+    const auto chunks = (count + report.chunk_size - 1) / report.chunk_size;
+    report.chunk_errors.assign(chunks, 0);
+    if (chunks == 0)
+    {
+        return report;
+    }
+
+    std::vector<ChunkErrors> errors(chunks);
+    auto done = std::make_shared<internal::TaskState<Void>>();
+    std::atomic<std::size_t> remaining{chunks};
+    std::atomic<bool> failed{false};
+    std::mutex failureMutex;
+    std::exception_ptr failure;
+    std::size_t posted = 0;
+    try
+    {
+        for (; posted < chunks; ++posted)
+        {
+            pool.post([&, chunk = posted, done] {
+                if (!failed.load(std::memory_order_relaxed))
+                {
+                    try
+                    {
+                        const auto first = chunk * report.chunk_size;
+                        const auto last = std::min(count, first + report.chunk_size);
+                        auto &chunkErrors = errors[chunk];
+                        for (auto index = first; index < last; ++index)
+                        {
+                            auto result = std::invoke(func, input[index]);
+                            if (result.is_ok())
+                            {
+                                output[index] = internal::ResultAccess::ok(std::move(result));
+                            }
+                            else
+                            {
+                                chunkErrors.push_back(
+                                    IndexedError<ErrType>{index, internal::ResultAccess::err(std::move(result))});
+                            }
+                        }
+                        report.chunk_errors[chunk] = chunkErrors.size();
+                    }
+                    catch (...)
+                    {
+                        failed.store(true, std::memory_order_relaxed);
+                        std::lock_guard<std::mutex> lock(failureMutex);
+                        if (!failure)
+                        {
+                            failure = std::current_exception();
+                        }
+                    }
+                }
+                if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    done->complete(Void());
+                }
+            });
+        }
+    }
+    catch (...)
+    {
+        // The chunks already posted point into this frame, they have to finish before it unwinds.
+        const auto unposted = chunks - posted;
+        if (remaining.fetch_sub(unposted, std::memory_order_acq_rel) == unposted)
+        {
+            done->complete(Void());
+        }
+        Task<Void>(done).wait();
+        throw;
+    }
+    Task<Void>(done).wait();
+    if (failure)
+    {
+        std::rethrow_exception(failure);
+    }
+
+    std::size_t total = 0;
+    for (const auto chunkCount : report.chunk_errors)
+    {
+        total += chunkCount;
+    }
+    report.errors.reserve(total);
+    for (auto &chunkErrors : errors)
+    {
+        std::move(chunkErrors.begin(), chunkErrors.end(), std::back_inserter(report.errors));
+    }
+    return report;
+}
+
+/// @brief Many Results stored column wise: one contiguous column of values, a validity bitmap with one bit
+/// per result, and the errors kept apart, sorted by index, since they are expected to be rare.
+///
+/// @details Storing a million `Result<T, E>` side by side spends the size of the largest payload on every
+/// element and a branch on reading each one. Here the values are dense, so map() runs over every lane
+/// without branching and the compiler can vectorize it, and the failed lanes are found from the bitmap a
+/// word of 64 at a time. Failed lanes hold a default constructed value, and are ignored by everything
+/// except map(), which runs on them too.
+///
+/// @example tests/result_test.cpp
+template <typename OkType, typename ErrType> class ResultBatch
+{
+  private:
+    static constexpr std::size_t word_bits = 64;
+
+    std::vector<OkType> _values;
+    std::vector<uint64_t> _validity;
+    std::vector<IndexedError<ErrType>> _errors;
+
+  public:
+    ResultBatch() = default;
+
+    /// @brief Makes room for `count` results up front
+    auto reserve(std::size_t count) -> void
+    {
+        _values.reserve(count);
+        _validity.reserve((count + word_bits - 1) / word_bits);
+    }
+
+    auto push_ok(OkType value) -> void
+    {
+        grow();
+        _validity.back() |= uint64_t{1} << ((_values.size() - 1) % word_bits);
+        _values.back() = std::move(value);
+    }
+
+    auto push_err(ErrType error) -> void
+    {
+        grow();
+        _errors.push_back(IndexedError<ErrType>{_values.size() - 1, std::move(error)});
+    }
+
+    /// @brief Appends a Result, moving its payload into the right column
+    auto push(Result<OkType, ErrType> &&result) -> void
+    {
+        if (result.is_ok())
+        {
+            push_ok(internal::ResultAccess::ok(std::move(result)));
+        }
+        else
+        {
+            push_err(internal::ResultAccess::err(std::move(result)));
+        }
+    }
+
+  public:
+    [[nodiscard]] auto size() const noexcept -> std::size_t
+    {
+        return _values.size();
+    }
+
+    [[nodiscard]] auto is_ok(std::size_t index) const noexcept -> bool
+    {
+        return ((_validity[index / word_bits] >> (index % word_bits)) & 1U) != 0;
+    }
+
+    /// @brief Get how many results are errors, by counting the unset validity bits
+    [[nodiscard]] auto error_count() const noexcept -> std::size_t
+    {
+        return size() - ok_count();
+    }
+
+    [[nodiscard]] auto ok_count() const noexcept -> std::size_t
+    {
+        std::size_t count = 0;
+        for (const auto word : _validity)
+        {
+            count += internal::popcount(word);
+        }
+        return count;
+    }
+
+    /// @brief Get the value column, failed lanes hold a default constructed value
+    [[nodiscard]] auto values() const noexcept -> Span<OkType const>
+    {
+        return Span<OkType const>(_values.data(), _values.size());
+    }
+
+    /// @brief Get the validity bitmap, bit `i % 64` of word `i / 64` is set when result `i` is ok
+    [[nodiscard]] auto validity() const noexcept -> Span<uint64_t const>
+    {
+        return Span<uint64_t const>(_validity.data(), _validity.size());
+    }
+
+    /// @brief Get every error with the index of its result, in index order
+    [[nodiscard]] auto errors() const noexcept -> Span<IndexedError<ErrType> const>
+    {
+        return Span<IndexedError<ErrType> const>(_errors.data(), _errors.size());
+    }
+
+    /// @brief Rebuilds result `index`, the error of a failed one is found by binary search
+    [[nodiscard]] auto get(std::size_t index) const -> Result<OkType, ErrType>
+    {
+        if (is_ok(index))
+        {
+            return Result<OkType, ErrType>(_values[index]);
+        }
+        const auto found = std::lower_bound(
+            _errors.begin(), _errors.end(), index,
+            [](IndexedError<ErrType> const &error, std::size_t wanted) { return error.index < wanted; });
+        return Result<OkType, ErrType>(found->error);
+    }
+
+    /// @brief Applies `func` to every lane of the value column, ok or not, without a branch per lane.
+    ///
+    /// @return A batch of the mapped values, with the same validity and errors
+    template <typename Function>
+    [[nodiscard]] auto map(Function &&func) const
+        -> ResultBatch<std::invoke_result_t<Function &, OkType const &>, ErrType>
+    {
+        ResultBatch<std::invoke_result_t<Function &, OkType const &>, ErrType> mapped;
+        mapped._values.resize(_values.size());
+        const auto count = _values.size();
+        auto const *in = _values.data();
+        auto *out = mapped._values.data();
+        for (std::size_t index = 0; index < count; ++index)
+        {
+            out[index] = func(in[index]);
+        }
+        mapped._validity = _validity;
+        mapped._errors = _errors;
+        return mapped;
+    }
+
+    /// @brief Calls `func(index, value)` for every ok result, skipping 64 failed lanes per bitmap word
+    template <typename Function> auto for_each_ok(Function &&func) const -> void
+    {
+        for (std::size_t word = 0; word < _validity.size(); ++word)
+        {
+            for (auto bits = _validity[word]; bits != 0; bits &= bits - 1)
+            {
+                const auto index = word * word_bits + internal::countr_zero(bits);
+                func(index, _values[index]);
+            }
+        }
+    }
+
+    /// @brief Calls `func(index, error)` for every failed result
+    template <typename Function> auto for_each_error(Function &&func) const -> void
+    {
+        for (auto const &error : _errors)
+        {
+            func(error.index, error.error);
+        }
+    }
+
+  private:
+    template <typename, typename> friend class ResultBatch;
+
+    /// @brief Appends an invalid lane
+    auto grow() -> void
+    {
+        if (_values.size() % word_bits == 0)
+        {
+            _validity.push_back(0);
+        }
+        _values.emplace_back();
+    }
+};
+
+/// @brief Gives a type a niche, a value it never legitimately holds, which Option<T> uses to mean "none"
+/// instead of a separate flag, so that `sizeof(Option<T>) == sizeof(T)`.
+///
+/// @details Pointers use nullptr. A TaggedFundamental uses the value of `Tag::niche` when its tag declares
+/// one, `class UserIdTag { public: static constexpr uint32_t niche = UINT32_MAX; };`. Specialize it for
+/// your own types with `available`, `none()` and `is_none()`.
+template <typename T, typename Enable = void> class OptionNiche
+{
+  public:
+    static constexpr bool available = false;
+};
+
+template <typename T> class OptionNiche<T *>
+{
+  public:
+    static constexpr bool available = true;
+
+    [[nodiscard]] static constexpr auto none() noexcept -> T *
+    {
+        return nullptr;
+    }
+
+    [[nodiscard]] static constexpr auto is_none(T *const &value) noexcept -> bool
+    {
+        return value == nullptr;
+    }
+};
+
+template <typename Tag, typename FundamentalType>
+class OptionNiche<TaggedFundamental<Tag, FundamentalType>, std::void_t<decltype(Tag::niche)>>
+{
+  public:
+    static constexpr bool available = true;
+
+    [[nodiscard]] static auto none() noexcept -> TaggedFundamental<Tag, FundamentalType>
+    {
+        return TaggedFundamental<Tag, FundamentalType>(static_cast<FundamentalType>(Tag::niche));
+    }
+
+    [[nodiscard]] static auto is_none(TaggedFundamental<Tag, FundamentalType> const &value) noexcept -> bool
+    {
+        return value.value == static_cast<FundamentalType>(Tag::niche);
+    }
+};
+
+namespace internal
+{
+/// @brief Option storage for types with a niche, the value itself says whether there is one.
+template <typename T, bool hasNiche = OptionNiche<T>::available> class OptionStorage
+{
+  private:
+    T _value = OptionNiche<T>::none();
+
+  public:
+    OptionStorage() noexcept = default;
+    explicit OptionStorage(T value) noexcept(std::is_nothrow_move_constructible_v<T>) : _value(std::move(value))
+    {
+    }
+
+    [[nodiscard]] auto has_value() const noexcept -> bool
+    {
+        return !OptionNiche<T>::is_none(_value);
+    }
+
+    [[nodiscard]] auto get() noexcept -> T &
+    {
+        return _value;
+    }
+
+    [[nodiscard]] auto get() const noexcept -> T const &
+    {
+        return _value;
+    }
+
+    auto reset() noexcept -> void
+    {
+        _value = OptionNiche<T>::none();
+    }
+
+    template <typename... Args> auto emplace(Args &&...args) -> T &
+    {
+        _value = T(std::forward<Args>(args)...);
+        return _value;
+    }
+};
+
+/// @brief Option storage for everything else, a std::optional.
+template <typename T> class OptionStorage<T, false>
+{
+  private:
+    std::optional<T> _value;
+
+  public:
+    OptionStorage() noexcept = default;
+    explicit OptionStorage(T value) noexcept(std::is_nothrow_move_constructible_v<T>) : _value(std::move(value))
+    {
+    }
+
+    [[nodiscard]] auto has_value() const noexcept -> bool
+    {
+        return _value.has_value();
+    }
+
+    [[nodiscard]] auto get() noexcept -> T &
+    {
+        return *_value;
+    }
+
+    [[nodiscard]] auto get() const noexcept -> T const &
+    {
+        return *_value;
+    }
+
+    auto reset() noexcept -> void
+    {
+        _value.reset();
+    }
+
+    template <typename... Args> auto emplace(Args &&...args) -> T &
+    {
+        return _value.emplace(std::forward<Args>(args)...);
+    }
+};
+} // namespace internal
+
+/// @brief An optional value, modeled after Rust's Option<T>, which is no larger than T when T has a niche.
+///
+/// @details Behaves like std::optional, and converts from one, but pointers and TaggedFundamentals whose tag
+/// declares a niche are stored without a flag: an `Option<Row *>` is one pointer, an `Option<UserId>` is one
+/// UserId. Storing the niche value itself gives an empty Option. ok_or() and transpose() move between
+/// Options and Results.
+///
+/// @example tests/result_test.cpp
+template <typename T> class Option
+{
+  private:
+    internal::OptionStorage<T> _storage;
+
+  public:
+    Option() noexcept = default;
+
+    // NOLINTNEXTLINE(google-explicit-constructor) mirrors std::optional
+    Option(std::nullopt_t /*none*/) noexcept
+    {
+    }
+
+    // NOLINTNEXTLINE(google-explicit-constructor) mirrors std::optional
+    Option(T value) noexcept(std::is_nothrow_move_constructible_v<T>) : _storage(std::move(value))
+    {
+    }
+
+    /// @brief From the std::optional returned by Result::ok(), only an exact std::optional<T> converts
+    template <typename Optional,
+              typename = std::enable_if_t<std::is_same_v<std::decay_t<Optional>, std::optional<T>>>>
+    // NOLINTNEXTLINE(google-explicit-constructor) mirrors std::optional
+    Option(Optional &&value)
+    {
+        if (value.has_value())
+        {
+            _storage.emplace(*std::forward<Optional>(value));
+        }
+    }
+
+  public:
+    [[nodiscard]] auto has_value() const noexcept -> bool
+    {
+        return _storage.has_value();
+    }
+
+    [[nodiscard]] auto is_some() const noexcept -> bool
+    {
+        return has_value();
+    }
+
+    [[nodiscard]] auto is_none() const noexcept -> bool
+    {
+        return !has_value();
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return has_value();
+    }
+
+    /// @brief Get the value, the Option must not be empty
+    [[nodiscard]] auto operator*() const & noexcept -> T const &
+    {
+        return _storage.get();
+    }
+
+    [[nodiscard]] auto operator*() & noexcept -> T &
+    {
+        return _storage.get();
+    }
+
+    [[nodiscard]] auto operator*() && noexcept -> T &&
+    {
+        return std::move(_storage.get());
+    }
+
+    [[nodiscard]] auto operator->() const noexcept -> T const *
+    {
+        return &_storage.get();
+    }
+
+    [[nodiscard]] auto operator->() noexcept -> T *
+    {
+        return &_storage.get();
+    }
+
+    /// @brief Get the value, throws std::bad_optional_access like std::optional when there is none
+    [[nodiscard]] auto value() const & -> T const &
+    {
+        if (!has_value())
+        {
+            throw std::bad_optional_access();
+        }
+        return _storage.get();
+    }
+
+    [[nodiscard]] auto value() && -> T
+    {
+        if (!has_value())
+        {
+            throw std::bad_optional_access();
+        }
+        return std::move(_storage.get());
+    }
+
+    [[nodiscard]] auto value_or(T fallback) const & -> T
+    {
+        return has_value() ? _storage.get() : fallback;
+    }
+
+    auto reset() noexcept -> void
+    {
+        _storage.reset();
+    }
+
+    template <typename... Args> auto emplace(Args &&...args) -> T &
+    {
+        return _storage.emplace(std::forward<Args>(args)...);
+    }
+
+    /// @brief Applies `func` to the value, if there is one
+    template <typename Function>
+    [[nodiscard]] auto map(Function &&func) const -> Option<std::invoke_result_t<Function, T const &>>
+    {
+        if (has_value())
+        {
+            return Option<std::invoke_result_t<Function, T const &>>(
+                std::invoke(std::forward<Function>(func), _storage.get()));
+        }
+        return std::nullopt;
+    }
+
+    /// @brief The value as an Ok Result, or `error` when there is none
+    template <typename ErrType> [[nodiscard]] auto ok_or(ErrType error) const & -> Result<T, ErrType>
+    {
+        if (has_value())
+        {
+            return Result<T, ErrType>(_storage.get());
+        }
+        return Result<T, ErrType>(std::move(error));
+    }
+
+    template <typename ErrType> [[nodiscard]] auto ok_or(ErrType error) && -> Result<T, ErrType>
+    {
+        if (has_value())
+        {
+            return Result<T, ErrType>(std::move(_storage.get()));
+        }
+        return Result<T, ErrType>(std::move(error));
+    }
+
+    /// @brief Like ok_or(), but the error is only built by `func` when it is needed
+    template <typename Function>
+    [[nodiscard]] auto ok_or_else(Function &&func) const & -> Result<T, std::invoke_result_t<Function>>
+    {
+        using ErrType = std::invoke_result_t<Function>;
+        if (has_value())
+        {
+            return Result<T, ErrType>(_storage.get());
+        }
+        return Result<T, ErrType>(std::invoke(std::forward<Function>(func)));
+    }
+
+    [[nodiscard]] auto to_optional() const & -> std::optional<T>
+    {
+        return has_value() ? std::optional<T>(_storage.get()) : std::nullopt;
+    }
+
+    [[nodiscard]] friend auto operator==(Option const &lhs, Option const &rhs) -> bool
+    {
+        if (lhs.has_value() != rhs.has_value())
+        {
+            return false;
+        }
+        return !lhs.has_value() || *lhs == *rhs;
+    }
+
+    [[nodiscard]] friend auto operator!=(Option const &lhs, Option const &rhs) -> bool
+    {
+        return !(lhs == rhs);
+    }
+};
+
+/// @brief Turns an optional Result inside out: none becomes Ok(none), Ok(value) becomes Ok(some value),
+/// and an error stays an error.
+template <typename OkType, typename ErrType>
+[[nodiscard]] auto transpose(Option<Result<OkType, ErrType>> option) -> Result<Option<OkType>, ErrType>
+{
+    if (option.is_none())
+    {
+        return Result<Option<OkType>, ErrType>(Option<OkType>());
+    }
+    auto &result = *option;
+    if (result.is_err())
+    {
+        return Result<Option<OkType>, ErrType>(internal::ResultAccess::err(std::move(result)));
+    }
+    return Result<Option<OkType>, ErrType>(Option<OkType>(internal::ResultAccess::ok(std::move(result))));
+}
+
+/// @brief Turns a Result of an Option inside out: Ok(none) becomes none, Ok(some value) becomes some
+/// Ok(value), and an error becomes some error.
+template <typename OkType, typename ErrType>
+[[nodiscard]] auto transpose(Result<Option<OkType>, ErrType> result) -> Option<Result<OkType, ErrType>>
+{
+    if (result.is_err())
+    {
+        return Option<Result<OkType, ErrType>>(
+            Result<OkType, ErrType>(internal::ResultAccess::err(std::move(result))));
+    }
+    auto &option = internal::ResultAccess::ok(result);
+    if (option.is_none())
+    {
+        return std::nullopt;
+    }
+    return Option<Result<OkType, ErrType>>(Result<OkType, ErrType>(*std::move(option)));
+}
+
+} // namespace etl
+
+namespace std
+{
+/// @brief A Result uses an allocator when either of its payloads does, which lets allocator aware containers
+/// hand their allocator down to the results they hold.
+template <typename OkType, typename ErrType, typename Allocator>
+struct uses_allocator<etl::Result<OkType, ErrType>, Allocator>
+    : bool_constant<uses_allocator_v<OkType, Allocator> || uses_allocator_v<ErrType, Allocator>>
+{
+};
+
+#if ETL_HAS_COROUTINES
+/// @brief Any function returning a Result can be a coroutine which `co_await`s other Results.
+template <typename OkType, typename ErrType, typename... Args>
+struct coroutine_traits<etl::Result<OkType, ErrType>, Args...>
+{
+    using promise_type = etl::internal::ResultPromise<OkType, ErrType>;
+};
+
+/// @brief Any function returning a Task can be a coroutine which `co_await`s other tasks and Results.
+template <typename ValueType, typename... Args> struct coroutine_traits<etl::Task<ValueType>, Args...>
+{
+    using promise_type = etl::internal::TaskPromise<ValueType>;
+};
+#endif
+} // namespace std
 
 #endif // __cplusplus >= 201702l
@@ -0,0 +1,98 @@
+#include <cstdint>
+#include <etl.hpp>
+#include <gtest/gtest.h>
+
+using namespace etl;
+
+namespace
+{
+
+enum class Message : uint8_t
+{
+    Ping = 0,
+    Pong,
+    Data,
+    Close,
+};
+
+using MessageRouter = EnumDispatch<Message, Message::Ping, Message::Close, int(int)>;
+
+auto onPing(int value) -> int
+{
+    return value + 1;
+}
+
+auto onData(int value) -> int
+{
+    return value * 2;
+}
+
+/// @brief Compile time handler generation, one instantiation per enumerator.
+template <Message message> struct MessageHandler
+{
+    static auto call(int value) -> int
+    {
+        return (static_cast<int>(message) * 100) + value;
+    }
+};
+
+} // namespace
+
+TEST(EtlEnumDispatch, DispatchToBoundHandlers)
+{
+    MessageRouter router;
+    router.bind(Message::Ping, onPing).bind(Message::Data, onData);
+
+    ASSERT_EQ(MessageRouter::size(), 4);
+    ASSERT_TRUE(router.is_bound(Message::Ping));
+    ASSERT_FALSE(router.is_bound(Message::Pong));
+
+    const auto ping = router.dispatch(Message::Ping, 41);
+    ASSERT_TRUE(ping.is_ok());
+    ASSERT_EQ(ping.ok().value(), 42);
+
+    const auto data = router.dispatch(Message::Data, 21);
+    ASSERT_TRUE(data.is_ok());
+    ASSERT_EQ(data.ok().value(), 42);
+}
+
+TEST(EtlEnumDispatch, UnboundAndOutOfRangeValuesAreErrors)
+{
+    MessageRouter router;
+    router.bind(Message::Ping, onPing);
+
+    const auto unbound = router.dispatch(Message::Close, 0);
+    ASSERT_TRUE(unbound.is_err());
+    ASSERT_EQ(unbound.err().value().msg(), "No handler bound to enumeration value");
+
+    const auto outOfRange = router.dispatch(static_cast<Message>(42), 0);
+    ASSERT_TRUE(outOfRange.is_err());
+    ASSERT_FALSE(router.is_bound(static_cast<Message>(42)));
+}
+
+TEST(EtlEnumDispatch, CompileTimeHandlerGeneration)
+{
+    // Comparing function pointers against nullptr is not a constant expression under -fsanitize=undefined,
+    // so the table is built at compile time and its bindings are checked at run time.
+    constexpr auto router = MessageRouter::create<MessageHandler>();
+    static_assert(MessageRouter::size() == 4);
+    ASSERT_TRUE(router.is_bound(Message::Ping));
+    ASSERT_TRUE(router.is_bound(Message::Close));
+
+    ASSERT_EQ(router.dispatch(Message::Ping, 7).ok().value(), 7);
+    ASSERT_EQ(router.dispatch(Message::Data, 7).ok().value(), 207);
+    ASSERT_EQ(router.dispatch(Message::Close, 7).ok().value(), 307);
+}
+
+TEST(EtlEnumDispatch, VoidHandlersReturnVoidResult)
+{
+    using Notifier = EnumDispatch<Message, Message::Ping, Message::Close, void(int &)>;
+
+    Notifier notifier;
+    notifier.bind(Message::Pong, [](int &counter) { ++counter; });
+
+    int counter = 0;
+    const auto result = notifier.dispatch(Message::Pong, counter);
+    ASSERT_TRUE(result.is_ok());
+    ASSERT_EQ(counter, 1);
+}
@@ -1,6 +1,12 @@
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <etl.hpp>
 #include <gtest/gtest.h>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
 #include <vector>
 
 TEST(EtlIterable, EnumIterTest)
@@ -28,3 +34,175 @@ TEST(EtlIterable, EnumIterTest)
     }
     EXPECT_EQ(numbers.size(), 10);
 }
+
+namespace
+{
+
+enum class Permissions : uint8_t
+{
+    None = 0,
+    Read = 1 << 0,
+    Write = 1 << 1,
+    Execute = 1 << 2,
+    Admin = 1 << 7,
+};
+
+ETL_ENABLE_FLAG_OPERATORS(Permissions)
+
+} // namespace
+
+TEST(EtlIterable, EnumFlagIterTest)
+{
+    const auto perms = Permissions::Read | Permissions::Execute | Permissions::Admin;
+
+    std::vector<Permissions> visited;
+    for (auto const &flag : etl::EnumerationFlagIterator<Permissions>(perms))
+    {
+        visited.push_back(flag);
+    }
+
+    const std::vector<Permissions> expected{Permissions::Read, Permissions::Execute, Permissions::Admin};
+    EXPECT_EQ(visited, expected);
+    EXPECT_EQ(etl::EnumerationFlagIterator<Permissions>(perms).size(), 3);
+    EXPECT_EQ(etl::EnumerationFlagIterator<Permissions>(Permissions::None).size(), 0);
+}
+
+TEST(EtlIterable, EnumFlagOperatorsTest)
+{
+    auto perms = Permissions::Read | Permissions::Write;
+    static_assert((Permissions::Read | Permissions::Write) != Permissions::None);
+
+    EXPECT_TRUE(etl::has_flags(perms, Permissions::Read));
+    EXPECT_TRUE(etl::has_flags(perms, Permissions::Read | Permissions::Write));
+    EXPECT_FALSE(etl::has_flags(perms, Permissions::Execute));
+
+    EXPECT_EQ(perms & Permissions::Write, Permissions::Write);
+    EXPECT_EQ(perms ^ Permissions::Write, Permissions::Read);
+    EXPECT_EQ(~Permissions::None & perms, perms);
+
+    perms |= Permissions::Execute;
+    EXPECT_TRUE(etl::has_flags(perms, Permissions::Execute));
+
+    perms &= ~Permissions::Read;
+    EXPECT_FALSE(etl::has_flags(perms, Permissions::Read));
+
+    perms ^= Permissions::Write;
+    EXPECT_EQ(perms, Permissions::Execute);
+}
+
+TEST(EtlIterable, EnumIterRandomAccessTest)
+{
+    enum class Shard : uint8_t
+    {
+        Zero = 0,
+        One,
+        Two,
+        Three,
+        Four,
+        Five,
+        Six,
+        Seven,
+    };
+
+    using ShardIterator = etl::EnumerationIterator<Shard, Shard::Zero, Shard::Seven>;
+    static_assert(std::is_same_v<std::iterator_traits<ShardIterator>::iterator_category,
+                                 std::random_access_iterator_tag>);
+    static_assert(ShardIterator::size() == 8);
+
+    const ShardIterator shards;
+    EXPECT_EQ(std::distance(shards.begin(), shards.end()), 8);
+    EXPECT_EQ(shards.end() - shards.begin(), 8);
+    EXPECT_EQ(shards[3], Shard::Three);
+    EXPECT_EQ(*(shards.begin() + 5), Shard::Five);
+    EXPECT_EQ(*(shards.end() - 1), Shard::Seven);
+    EXPECT_EQ(*(2 + shards.begin()), Shard::Two);
+    EXPECT_TRUE(shards.begin() < shards.end());
+
+    const auto found = std::lower_bound(shards.begin(), shards.end(), Shard::Six);
+    EXPECT_EQ(*found, Shard::Six);
+    EXPECT_EQ(found - shards.begin(), 6);
+
+    const std::vector<Shard> reversed(std::make_reverse_iterator(shards.end()),
+                                      std::make_reverse_iterator(shards.begin()));
+    ASSERT_EQ(reversed.size(), ShardIterator::size());
+    EXPECT_EQ(reversed.front(), Shard::Seven);
+    EXPECT_EQ(reversed.back(), Shard::Zero);
+}
+
+TEST(EtlIterable, EnumArrayTest)
+{
+    enum class Venue : uint8_t
+    {
+        Nyse = 1,
+        Nasdaq,
+        Cboe,
+    };
+
+    etl::EnumArray<Venue, Venue::Nyse, Venue::Cboe, int> volume;
+    static_assert(decltype(volume)::size() == 3);
+
+    volume[Venue::Nasdaq] = 42;
+    EXPECT_EQ(volume[Venue::Nyse], 0);
+    EXPECT_EQ(volume[Venue::Nasdaq], 42);
+    EXPECT_EQ(std::accumulate(volume.begin(), volume.end(), 0), 42);
+}
+
+TEST(EtlIterable, ParallelForEachEnumAggregatesErrors)
+{
+    enum class Region : uint8_t
+    {
+        Africa = 0,
+        Americas,
+        Asia,
+        Europe,
+        Oceania,
+        Antarctica,
+    };
+
+    std::atomic<int> calls{0};
+    const auto results = etl::parallel_for_each_enum<Region, Region::Africa, Region::Antarctica>(
+        [&calls](Region region) -> etl::Result<int, etl::Error> {
+            ++calls;
+            if (region == Region::Asia || region == Region::Antarctica)
+            {
+                return etl::Result<int, etl::Error>(etl::Error::create("shard rebuild failed"));
+            }
+            return etl::Result<int, etl::Error>(static_cast<int>(region) * 10);
+        },
+        4);
+
+    EXPECT_EQ(calls.load(), 6);
+    EXPECT_EQ(results[Region::Europe].ok().value(), 30);
+    EXPECT_EQ(results[Region::Oceania].ok().value(), 40);
+    EXPECT_TRUE(results[Region::Asia].is_err());
+    EXPECT_TRUE(results[Region::Antarctica].is_err());
+
+    const auto errors = std::count_if(results.begin(), results.end(), [](auto const &result) { return result.is_err(); });
+    EXPECT_EQ(errors, 2);
+}
+
+TEST(EtlIterable, ParallelForEachEnumRethrowsTheFirstException)
+{
+    enum class Region : uint8_t
+    {
+        Africa = 0,
+        Americas,
+        Asia,
+        Europe,
+        Oceania,
+        Antarctica,
+    };
+
+    const auto run = []() {
+        return etl::parallel_for_each_enum<Region, Region::Africa, Region::Antarctica>(
+            [](Region region) -> int {
+                if (region == Region::Asia)
+                {
+                    throw std::runtime_error("shard rebuild failed");
+                }
+                return static_cast<int>(region);
+            },
+            4);
+    };
+    EXPECT_THROW(static_cast<void>(run()), std::runtime_error);
+}
@@ -0,0 +1,73 @@
+#include <cstddef>
+#include <cstdint>
+#include <etl.hpp>
+#include <gtest/gtest.h>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if !defined(ETL_ERROR_SITE_COUNTERS)
+#error "error_site_test.cpp has to be built with ETL_ERROR_SITE_COUNTERS defined"
+#endif
+
+using namespace etl;
+
+namespace
+{
+constexpr uint32_t counted_site_line = __LINE__ + 3;
+auto failAtCountedSite() -> Error
+{
+    return Error::create("Counted", RUNTIME_INFO);
+}
+
+auto countedSite() -> std::optional<ErrorSiteCount>
+{
+    for (auto const &site : error_site_counts())
+    {
+        if (site.function.find("failAtCountedSite") != std::string_view::npos)
+        {
+            return site;
+        }
+    }
+    return std::nullopt;
+}
+} // namespace
+
+TEST(EtlErrorSite, CountsErrorsPerCallSite)
+{
+    constexpr std::size_t threads = 4;
+    constexpr std::size_t errors_per_thread = 1000;
+
+    const auto before = failAtCountedSite();
+    const auto initial = countedSite();
+    ASSERT_TRUE(initial.has_value());
+    ASSERT_EQ(initial->file, __FILE__);
+    ASSERT_EQ(initial->line, counted_site_line);
+    ASSERT_EQ(before.location()->line(), counted_site_line);
+
+    std::vector<std::thread> workers;
+    for (std::size_t thread = 0; thread < threads; ++thread)
+    {
+        workers.emplace_back([] {
+            for (std::size_t i = 0; i < errors_per_thread; ++i)
+            {
+                ASSERT_EQ(failAtCountedSite().msg(), "Counted");
+            }
+        });
+    }
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+
+    ASSERT_EQ(countedSite()->count, initial->count + (threads * errors_per_thread));
+
+    // Locations built by hand are never counted.
+    const auto uncounted = Error::create("Uncounted", SourceCodeLocation(__FILE__, 1, "handBuiltSite"));
+    ASSERT_EQ(uncounted.location()->site(), nullptr);
+    for (auto const &site : error_site_counts())
+    {
+        ASSERT_NE(site.function, "handBuiltSite");
+    }
+}
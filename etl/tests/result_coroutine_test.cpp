@@ -0,0 +1,164 @@
+#include <etl.hpp>
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace etl;
+
+#if ETL_HAS_COROUTINES
+
+namespace
+{
+
+auto parseDigit(char digit) -> Result<int, Error>
+{
+    if (digit < '0' || digit > '9')
+    {
+        return Result<int, Error>(Error::create("Not a digit"));
+    }
+    return Result<int, Error>(digit - '0');
+}
+
+auto parseTwoDigits(std::string const &text) -> Result<int, Error>
+{
+    const int tens = co_await parseDigit(text[0]);
+    const int ones = co_await parseDigit(text[1]);
+    co_return tens * 10 + ones;
+}
+
+auto sumOfTwoNumbers(std::string const &first, std::string const &second) -> Result<int, Error>
+{
+    const auto parsed = parseTwoDigits(second);
+    co_return co_await parseTwoDigits(first) + co_await parsed;
+}
+
+auto makeOwned(int value) -> Result<std::unique_ptr<int>, Error>
+{
+    co_return std::make_unique<int>(co_await parseDigit(static_cast<char>('0' + value)));
+}
+
+auto rejectNegative(int value) -> Result<Void, Error>
+{
+    if (value < 0)
+    {
+        co_return Error::create("Negative");
+    }
+    co_return Void();
+}
+
+auto sumOnPool(ThreadPool &pool, std::string first, std::string second) -> Task<Result<int, Error>>
+{
+    co_await schedule(pool);
+    auto left = pool.spawn([first] { return parseTwoDigits(first); });
+    auto right = pool.spawn([second] { return parseTwoDigits(second); });
+    const int sum = co_await co_await left + co_await co_await right;
+    co_return sum;
+}
+
+} // namespace
+
+TEST(EtlResultCoroutine, AwaitingOkResultsResumesWithTheirValues)
+{
+    const auto result = parseTwoDigits("42");
+    ASSERT_TRUE(result.is_ok());
+    ASSERT_EQ(result.ok().value(), 42);
+
+    const auto sum = sumOfTwoNumbers("12", "30");
+    ASSERT_TRUE(sum.is_ok());
+    ASSERT_EQ(sum.ok().value(), 42);
+
+    auto owned = makeOwned(7);
+    ASSERT_TRUE(owned.is_ok());
+    ASSERT_EQ(*std::move(owned).ok().value(), 7);
+
+    ASSERT_TRUE(rejectNegative(1).is_ok());
+}
+
+TEST(EtlResultCoroutine, AwaitingAnErrorReturnsItImmediately)
+{
+    const auto first = parseTwoDigits("x2");
+    ASSERT_TRUE(first.is_err());
+    ASSERT_EQ(first.err()->msg(), "Not a digit");
+
+    const auto second = sumOfTwoNumbers("12", "3y");
+    ASSERT_TRUE(second.is_err());
+    ASSERT_EQ(second.err()->msg(), "Not a digit");
+
+    ASSERT_EQ(rejectNegative(-1).err()->msg(), "Negative");
+}
+
+TEST(EtlResultCoroutine, FramesAreReleasedInOrder)
+{
+    // Every frame goes back to the per thread stack, so this would exhaust it if any leaked.
+    for (int i = 0; i < 100'000; ++i)
+    {
+        ASSERT_EQ(sumOfTwoNumbers(i % 2 == 0 ? "12" : "1x", "30").is_ok(), i % 2 == 0);
+    }
+}
+
+namespace
+{
+template <typename Promise, typename Awaitable>
+concept AwaitableFrom = requires(Promise &promise, Awaitable &&awaitable) {
+    promise.await_transform(std::forward<Awaitable>(awaitable));
+};
+
+template <typename Awaiter, typename Handle>
+concept SuspendsHandle = requires(Awaiter &awaiter, Handle handle) { awaiter.await_suspend(handle); };
+} // namespace
+
+TEST(EtlResultCoroutine, OnlyResultsCanBeAwaited)
+{
+    // Anything that can suspend would leave the caller reading a Result that isn't there yet.
+    using Promise = internal::ResultPromise<int, Error>;
+    static_assert(AwaitableFrom<Promise, Result<int, Error>>);
+    static_assert(AwaitableFrom<Promise, Result<int, Error> const &>);
+    static_assert(AwaitableFrom<Promise, Result<int, StaticError> &>);
+    static_assert(!AwaitableFrom<Promise, Task<int> const &>);
+    static_assert(!AwaitableFrom<Promise, std::suspend_always>);
+
+    // Tasks in turn only suspend coroutines whose frames may be resumed on another thread.
+    static_assert(SuspendsHandle<internal::TaskAwaiter<int>, std::coroutine_handle<internal::TaskPromise<bool>>>);
+    static_assert(!SuspendsHandle<internal::TaskAwaiter<int>, std::coroutine_handle<>>);
+    static_assert(!SuspendsHandle<internal::TaskAwaiter<int>, std::coroutine_handle<Promise>>);
+    SUCCEED();
+}
+
+TEST(EtlResultCoroutine, TasksAwaitTasksAndResults)
+{
+    ThreadPool pool(4);
+    const auto caller = std::this_thread::get_id();
+    auto onPool = [&pool]() -> Task<std::thread::id> {
+        co_await schedule(pool);
+        co_return std::this_thread::get_id();
+    };
+    ASSERT_NE(onPool().get(), caller);
+
+    ASSERT_EQ(sumOnPool(pool, "12", "30").get().ok().value(), 42);
+    ASSERT_EQ(sumOnPool(pool, "12", "3y").get().err()->msg(), "Not a digit");
+
+    // An exception escaping a task coroutine is stored in its task, and rethrown to whoever awaits it.
+    auto failing = [&pool]() -> Task<int> {
+        co_await schedule(pool);
+        throw std::runtime_error("coroutine failed");
+    };
+    auto awaiting = [&failing]() -> Task<int> { co_return co_await failing() + 1; };
+    EXPECT_THROW(static_cast<void>(awaiting().get()), std::runtime_error);
+
+    std::vector<Task<Result<int, Error>>> tasks;
+    for (int i = 0; i < 80; ++i)
+    {
+        tasks.push_back(sumOnPool(pool, "10", std::to_string(10 + i)));
+    }
+    const auto results = when_all(std::move(tasks)).get();
+    for (int i = 0; i < 80; ++i)
+    {
+        ASSERT_EQ(results[static_cast<std::size_t>(i)].ok().value(), 20 + i);
+    }
+}
+
+#endif
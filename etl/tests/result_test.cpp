@@ -1,7 +1,20 @@
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <etl.hpp>
 #include <gtest/gtest.h>
+#include <limits>
 #include <memory>
+#include <memory_resource>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 using namespace etl;
 
@@ -104,3 +117,680 @@ TEST(EtlResult, ResultErrTypeUniquePtrSpecializationTest)
     ASSERT_FALSE(result.is_ok());
     ASSERT_EQ(result.err().value(), "This is an error");
 }
+
+TEST(EtlResult, ErrorInfoIsFormattedFromTheSourceLocation)
+{
+    const auto line = static_cast<uint32_t>(__LINE__ + 1);
+    const auto error = Error::create("Something failed", RUNTIME_INFO);
+
+    ASSERT_TRUE(error.location().has_value());
+    ASSERT_EQ(error.location()->line(), line);
+    ASSERT_EQ(error.msg(), "Something failed");
+    ASSERT_EQ(error.info().find("Error: Something failed\nFunction: "), 0U);
+    ASSERT_NE(error.info().find(std::string(__FILE__) + ":" + std::to_string(line)), std::string::npos);
+
+    // Without ETL_ERROR_SITE_COUNTERS the macro is a plain constructor call, fine in unevaluated operands.
+    static_assert(std::is_same_v<decltype(RUNTIME_INFO), SourceCodeLocation>);
+
+    const auto plain = Error::create("Something failed");
+    ASSERT_FALSE(plain.location().has_value());
+    ASSERT_EQ(plain.info(), "Something failed");
+}
+
+TEST(EtlResult, SourceCodeLocationOnlyViewsStringsThatOutliveIt)
+{
+    // Runtime strings would dangle once the temporary is gone, they have to be passed as borrowed.
+    static_assert(!std::is_constructible_v<SourceCodeLocation, std::string, uint32_t, std::string>);
+    static_assert(!std::is_constructible_v<SourceCodeLocation, std::string_view, uint32_t, std::string_view>);
+    static_assert(std::is_constructible_v<SourceCodeLocation, BorrowedStrings, std::string, uint32_t, std::string>);
+
+    const SourceCodeLocation literal("store.cpp", 42, "flush");
+    ASSERT_EQ(literal.file(), "store.cpp");
+    ASSERT_EQ(literal.function(), "flush");
+
+    const std::string file = "journal.cpp";
+    const SourceCodeLocation borrowed(borrowed_strings, file, 7, "append");
+    ASSERT_EQ(borrowed.file().data(), file.data());
+    ASSERT_EQ(borrowed.line(), 7U);
+}
+
+namespace
+{
+const auto empty_queue = StaticError::create("Queue is empty", 7);
+
+auto pop(std::vector<int> &queue) noexcept -> Result<int, StaticError>
+{
+    if (queue.empty())
+    {
+        return Result<int, StaticError>(empty_queue);
+    }
+    const auto value = queue.back();
+    queue.pop_back();
+    return Result<int, StaticError>(value);
+}
+} // namespace
+
+TEST(EtlResult, StaticErrorTest)
+{
+    std::vector<int> queue{1};
+
+    ASSERT_EQ(pop(queue).ok().value(), 1);
+    const auto result = pop(queue);
+    ASSERT_TRUE(result.is_err());
+    ASSERT_EQ(result.err().value(), empty_queue);
+    ASSERT_EQ(result.err().value().code(), 7);
+    ASSERT_EQ(result.err().value().view(), "Queue is empty");
+    ASSERT_EQ(result.err().value().msg(), "Queue is empty");
+    ASSERT_EQ(result.err().value().info(), "Queue is empty");
+    ASSERT_NE(result.err().value(), StaticError::create("Queue is empty"));
+}
+
+TEST(EtlResult, PmrErrorAllocatesFromTheGivenResource)
+{
+    // The arena has no upstream, so any allocation that escapes it throws.
+    std::array<std::byte, 1024> buffer{};
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+
+    const auto error = pmr::Error::create("A message too long for the small string buffer", RUNTIME_INFO, &arena);
+    ASSERT_EQ(error.get_allocator().resource(), &arena);
+    ASSERT_EQ(error.view(), "A message too long for the small string buffer");
+
+    const Result<int, pmr::Error> result(error);
+    ASSERT_EQ(result.err().value().get_allocator().resource(), &arena);
+    ASSERT_EQ(result.err().value().msg(), error.msg());
+
+    // Copies allocate from the original's resource, assignment keeps the target's, as the containers do.
+    const auto copy = error;
+    ASSERT_EQ(copy.get_allocator().resource(), &arena);
+    auto assigned = pmr::Error::create("Assigned to", std::pmr::new_delete_resource());
+    assigned = error;
+    ASSERT_EQ(assigned.get_allocator().resource(), std::pmr::new_delete_resource());
+    ASSERT_EQ(assigned.msg(), error.msg());
+}
+
+TEST(EtlResult, PmrErrorResourceScope)
+{
+    std::array<std::byte, 1024> buffer{};
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+
+    ASSERT_EQ(pmr::error_resource(), std::pmr::get_default_resource());
+    {
+        const pmr::ErrorResourceScope scope(&arena);
+        ASSERT_EQ(pmr::error_resource(), &arena);
+        const auto error = pmr::Error::create("A message too long for the small string buffer");
+        ASSERT_EQ(error.get_allocator().resource(), &arena);
+    }
+    ASSERT_EQ(pmr::error_resource(), std::pmr::get_default_resource());
+    ASSERT_EQ(pmr::Error::create("Outside").get_allocator().resource(), std::pmr::get_default_resource());
+}
+
+TEST(EtlResult, ResultAllocatorExtendedConstruction)
+{
+    std::array<std::byte, 4096> buffer{};
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+    const std::pmr::polymorphic_allocator<char> allocator(&arena);
+
+    using PmrResult = Result<std::pmr::string, pmr::Error>;
+    static_assert(std::uses_allocator_v<PmrResult, std::pmr::polymorphic_allocator<char>>);
+    static_assert(!std::uses_allocator_v<Result<int, StaticError>, std::pmr::polymorphic_allocator<char>>);
+
+    // The payloads come from the default resource, the results copy them into the arena.
+    const std::pmr::string value("A value too long for the small string buffer");
+    const PmrResult ok(std::allocator_arg, allocator, value);
+    ASSERT_TRUE(ok.is_ok());
+    ASSERT_EQ(ok.ok().value(), value);
+
+    auto error = pmr::Error::create("An error too long for the small string buffer", std::pmr::get_default_resource());
+    const PmrResult err(std::allocator_arg, allocator, std::move(error));
+    ASSERT_TRUE(err.is_err());
+    ASSERT_EQ(err.err().value().get_allocator().resource(), &arena);
+
+    // Containers propagate their allocator into every element.
+    std::pmr::vector<PmrResult> results(&arena);
+    results.push_back(ok);
+    results.push_back(err);
+    results.emplace_back(PmrResult(value));
+    ASSERT_EQ(results.size(), 3U);
+    ASSERT_TRUE(results[0].is_ok());
+    ASSERT_TRUE(results[1].is_err());
+    ASSERT_EQ(results[1].err().value().get_allocator().resource(), &arena);
+    ASSERT_EQ(results[2].ok().value(), value);
+}
+
+TEST(EtlResult, ReferenceResultAllocatorExtendedConstruction)
+{
+    std::array<std::byte, 4096> buffer{};
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+
+    // The reference is copied as is, only the error picks up the container's allocator.
+    using RowResult = Result<int &, pmr::Error>;
+    static_assert(std::uses_allocator_v<RowResult, std::pmr::polymorphic_allocator<char>>);
+    int row = 7;
+    const RowResult found(row);
+    const RowResult missing(
+        pmr::Error::create("A missing row with a message too long for the small string buffer",
+                           std::pmr::get_default_resource()));
+
+    std::pmr::vector<RowResult> results(&arena);
+    results.push_back(found);
+    results.push_back(missing);
+    results.emplace_back(RowResult(row));
+    ASSERT_EQ(results.size(), 3U);
+    ASSERT_EQ(&results[0].get(), &row);
+    ASSERT_TRUE(results[1].is_err());
+    ASSERT_EQ(results[1].err().value().get_allocator().resource(), &arena);
+    ASSERT_EQ(results[1].err().value().msg(), missing.err().value().msg());
+    ASSERT_EQ(&results[2].get(), &row);
+}
+
+namespace
+{
+auto parseHeader() -> Result<int, Error>
+{
+    return Result<int, Error>(Error::create("Unexpected end of input", RUNTIME_INFO));
+}
+
+auto loadFile() -> Result<int, Error>
+{
+    return parseHeader().map_err(
+        [](Error error) -> Error { return std::move(error).context("while parsing header", RUNTIME_INFO); });
+}
+} // namespace
+
+TEST(EtlResult, ErrorContextFrames)
+{
+    const auto result = loadFile();
+    ASSERT_TRUE(result.is_err());
+
+    auto error = result.err().value();
+    error.context("while loading file config.toml").context("while starting up", RUNTIME_INFO);
+    for (auto frame = 0; frame < 3; ++frame)
+    {
+        error.context("while retrying");
+    }
+
+    // The first frames live in the context block, the rest spilled, both read back the same way.
+    ASSERT_GT(error.context_count(), Error::block_context_frames);
+    ASSERT_EQ(error.context_count(), 6U);
+    ASSERT_EQ(error.msg(), "Unexpected end of input");
+    ASSERT_EQ(error.context_message(0), "while parsing header");
+    ASSERT_TRUE(error.context_location(0).has_value());
+    ASSERT_EQ(error.context_message(1), "while loading file config.toml");
+    ASSERT_FALSE(error.context_location(1).has_value());
+    ASSERT_EQ(error.context_message(2), "while starting up");
+    ASSERT_TRUE(error.context_location(2).has_value());
+    ASSERT_EQ(error.context_message(5), "while retrying");
+
+    const auto info = error.info();
+    ASSERT_EQ(info.find("Error: Unexpected end of input\nFunction: "), 0U);
+    const auto parsing = info.find("\nContext: while parsing header\n  Function: ");
+    const auto loading = info.find("\nContext: while loading file config.toml\nContext: while starting up\n");
+    ASSERT_NE(parsing, std::string::npos);
+    ASSERT_NE(loading, std::string::npos);
+    ASSERT_LT(parsing, loading);
+
+    const auto copy = error;
+    ASSERT_EQ(copy.context_count(), error.context_count());
+    ASSERT_EQ(copy.info(), info);
+
+    ASSERT_EQ(Error::create("No context").context("while testing").info(), "Error: No context\nContext: while testing");
+}
+
+namespace
+{
+/// @brief Forwards to the default resource, counting the allocations it passes on.
+class CountingResource : public std::pmr::memory_resource
+{
+  public:
+    std::size_t allocations{0};
+
+  private:
+    auto do_allocate(std::size_t bytes, std::size_t alignment) -> void * override
+    {
+        ++allocations;
+        return std::pmr::get_default_resource()->allocate(bytes, alignment);
+    }
+
+    auto do_deallocate(void *pointer, std::size_t bytes, std::size_t alignment) -> void override
+    {
+        std::pmr::get_default_resource()->deallocate(pointer, bytes, alignment);
+    }
+
+    [[nodiscard]] auto do_is_equal(std::pmr::memory_resource const &other) const noexcept -> bool override
+    {
+        return this == &other;
+    }
+};
+} // namespace
+
+TEST(EtlResult, ErrorContextIsOneLazyAllocation)
+{
+    // Without context an error is its message and location, the frames cost a pointer until they are attached.
+    static_assert(sizeof(Error) <= sizeof(IError) + sizeof(std::string) + sizeof(std::optional<SourceCodeLocation>) +
+                                       sizeof(void *));
+
+    CountingResource resource;
+    auto error = pmr::Error::create("Short", &resource);
+    ASSERT_EQ(resource.allocations, 0U);
+
+    // Frame text longer than the small string buffer still lands in the one block.
+    error.context("while replaying the write ahead log of shard seven").context("while recovering", RUNTIME_INFO);
+    ASSERT_EQ(resource.allocations, 1U);
+    ASSERT_EQ(error.context_message(0), "while replaying the write ahead log of shard seven");
+    ASSERT_EQ(error.context_message(1), "while recovering");
+
+    // Text past the block's buffer spills, and reads back the same way.
+    const std::string longFrame(pmr::Error::block_context_text, 'x');
+    error.context(longFrame).context("after the spill");
+    ASSERT_EQ(error.context_message(2), longFrame);
+    ASSERT_EQ(error.context_message(3), "after the spill");
+
+    // Moving hands the block over, copying duplicates it.
+    auto moved = std::move(error);
+    ASSERT_EQ(moved.context_count(), 4U);
+    const auto copy = moved;
+    ASSERT_EQ(copy.context_message(0), moved.context_message(0));
+    ASSERT_EQ(copy.info(), moved.info());
+}
+
+TEST(EtlResult, CollectStopsAtTheFirstError)
+{
+    const std::vector<int> numbers{6, 3, 2};
+    const auto quotients = collect(numbers, [](int value) { return divide(12, value); });
+    ASSERT_TRUE(quotients.is_ok());
+    ASSERT_EQ(quotients.ok().value(), (std::vector<int>{2, 4, 6}));
+
+    std::size_t calls = 0;
+    const std::vector<int> withZeros{6, 0, 2, 0};
+    const auto failed = collect(withZeros.begin(), withZeros.end(), [&calls](int value) {
+        ++calls;
+        return divide(12, value);
+    });
+    ASSERT_TRUE(failed.is_err());
+    ASSERT_EQ(failed.err()->msg(), "Division by zero Error");
+    ASSERT_EQ(calls, 2);
+
+    const auto empty = collect(std::vector<int>(), [](int value) { return divide(12, value); });
+    ASSERT_TRUE(empty.ok()->empty());
+
+    // Move only values are moved out of each result.
+    auto owned = collect(numbers, [](int value) {
+        return Result<std::unique_ptr<int>, Error>(std::make_unique<int>(value));
+    });
+    ASSERT_EQ(*std::move(owned).ok().value()[2], 2);
+}
+
+TEST(EtlResult, CollectAllErrorsGathersEveryError)
+{
+    const std::vector<int> withZeros{6, 0, 2, 0};
+    const auto failed = collect_all_errors(withZeros, [](int value) { return divide(12, value); });
+    ASSERT_TRUE(failed.is_err());
+    ASSERT_EQ(failed.err()->size(), 2);
+
+    const std::vector<int> numbers{6, 3, 2};
+    const auto quotients = collect_all_errors(numbers, [](int value) { return divide(12, value); });
+    ASSERT_EQ(quotients.ok().value(), (std::vector<int>{2, 4, 6}));
+}
+
+TEST(EtlResult, ResultBatchKeepsValuesAndErrorsInColumns)
+{
+    ResultBatch<int, Error> batch;
+    batch.reserve(200);
+    for (int value = 0; value < 200; ++value)
+    {
+        batch.push(divide(value, value % 50 == 7 ? 0 : 1));
+    }
+    ASSERT_EQ(batch.size(), 200);
+    ASSERT_EQ(batch.error_count(), 4);
+    ASSERT_EQ(batch.ok_count(), 196);
+    ASSERT_EQ(batch.validity().size(), 4);
+    ASSERT_TRUE(batch.is_ok(6));
+    ASSERT_FALSE(batch.is_ok(157));
+    ASSERT_EQ(batch.get(6).ok().value(), 6);
+    ASSERT_EQ(batch.get(157).err()->msg(), "Division by zero Error");
+
+    std::vector<std::size_t> failed;
+    batch.for_each_error([&failed](std::size_t index, Error const &) { failed.push_back(index); });
+    ASSERT_EQ(failed, (std::vector<std::size_t>{7, 57, 107, 157}));
+
+    const auto doubled = batch.map([](int value) { return static_cast<int64_t>(value) * 2; });
+    ASSERT_EQ(doubled.error_count(), 4);
+    ASSERT_EQ(doubled.values()[199], 398);
+    ASSERT_EQ(doubled.get(107).err()->msg(), "Division by zero Error");
+
+    int64_t sum = 0;
+    std::size_t visited = 0;
+    doubled.for_each_ok([&](std::size_t index, int64_t value) {
+        ASSERT_TRUE(doubled.is_ok(index));
+        sum += value;
+        ++visited;
+    });
+    ASSERT_EQ(visited, 196);
+    ASSERT_EQ(sum, 199 * 200 - 2 * (7 + 57 + 107 + 157));
+}
+
+namespace
+{
+class UserIdTag
+{
+  public:
+    static constexpr uint32_t niche = UINT32_MAX;
+};
+using UserId = TaggedFundamental<UserIdTag, uint32_t>;
+} // namespace
+
+TEST(EtlResult, OptionUsesNichesInsteadOfAFlag)
+{
+    static_assert(sizeof(Option<int *>) == sizeof(int *));
+    static_assert(sizeof(Option<UserId>) == sizeof(UserId));
+    static_assert(sizeof(Option<UserId>) < sizeof(std::optional<UserId>));
+
+    int row = 42;
+    Option<int *> found(&row);
+    ASSERT_TRUE(found.is_some());
+    ASSERT_EQ(**found, 42);
+    found.reset();
+    ASSERT_TRUE(found.is_none());
+    ASSERT_FALSE(Option<int *>(nullptr).has_value());
+
+    Option<UserId> user;
+    ASSERT_TRUE(user.is_none());
+    user.emplace(7U);
+    ASSERT_EQ(user->value, 7);
+    ASSERT_EQ(user.map([](UserId const &id) { return id.value * 2; }), Option<uint32_t>(14U));
+    ASSERT_TRUE(Option<UserId>(UserId(UINT32_MAX)).is_none());
+
+    // Everything else falls back to a flag.
+    Option<std::string> name = divide(4, 2).ok().has_value() ? Option<std::string>("etl") : std::nullopt;
+    ASSERT_EQ(name.value_or("none"), "etl");
+    ASSERT_THROW(static_cast<void>(Option<std::string>().value()), std::bad_optional_access);
+}
+
+TEST(EtlResult, OptionConvertsToAndFromResult)
+{
+    const Option<int> some = divide(8, 2).ok();
+    ASSERT_EQ(some.ok_or(StaticError::create("Missing")).ok().value(), 4);
+    const Option<int> none = divide(8, 0).ok();
+    ASSERT_EQ(none.ok_or(StaticError::create("Missing")).err()->view(), "Missing");
+    ASSERT_EQ(none.ok_or_else([] { return Error::create("Built lazily"); }).err()->msg(), "Built lazily");
+
+    const auto okSome = transpose(Option<Result<int, Error>>(divide(8, 2)));
+    ASSERT_EQ(*okSome.ok().value(), 4);
+    ASSERT_TRUE(transpose(Option<Result<int, Error>>()).ok()->is_none());
+    ASSERT_TRUE(transpose(Option<Result<int, Error>>(divide(8, 0))).is_err());
+
+    const auto someOk = transpose(Result<Option<int>, Error>(Option<int>(4)));
+    ASSERT_EQ(someOk->ok().value(), 4);
+    ASSERT_TRUE(transpose(Result<Option<int>, Error>(Option<int>())).is_none());
+    ASSERT_TRUE(transpose(Result<Option<int>, Error>(Error::create("Failed")))->is_err());
+}
+
+namespace
+{
+class Row
+{
+  public:
+    uint32_t id{0};
+    std::string name;
+};
+
+auto findRow(std::vector<Row> &table, uint32_t id) -> Result<Row &, Error>
+{
+    for (auto &row : table)
+    {
+        if (row.id == id)
+        {
+            return Result<Row &, Error>(row);
+        }
+    }
+    return Result<Row &, Error>(Error::create("No row with id " + std::to_string(id)));
+}
+} // namespace
+
+TEST(EtlResult, ReferenceResultsReturnViewsWithoutCopying)
+{
+    static_assert(!std::is_constructible_v<Result<Row const &, Error>, Row &&>);
+
+    std::vector<Row> table{{1, "first"}, {2, "second"}};
+    auto found = findRow(table, 2);
+    ASSERT_TRUE(found.is_ok());
+    ASSERT_EQ(&found.get(), &table[1]);
+    Row &viaOk = found.ok().value();
+    ASSERT_EQ(&viaOk, &table[1]);
+
+    found.get().name = "renamed";
+    ASSERT_EQ(table[1].name, "renamed");
+
+    // Mapping to a member keeps referring into the table, mapping to a value copies.
+    auto name = found.map([](Row &row) -> std::string & { return row.name; });
+    ASSERT_EQ(&name.get(), &table[1].name);
+    const auto length = found.map([](Row const &row) { return row.name.size(); });
+    ASSERT_EQ(length.ok().value(), 7);
+
+    const auto missing = findRow(table, 3);
+    ASSERT_TRUE(missing.is_err());
+    ASSERT_FALSE(missing.ok().has_value());
+    ASSERT_EQ(missing.err()->msg(), "No row with id 3");
+    ASSERT_EQ(missing.map([](Row const &row) { return row.id; }).err()->msg(), "No row with id 3");
+    const auto relabeled = missing.map_err([](Error const &) { return Error::create("Lookup failed"); });
+    ASSERT_EQ(relabeled.err()->msg(), "Lookup failed");
+}
+
+TEST(EtlResult, SerializeRoundTrip)
+{
+    std::array<std::byte, 512> buffer{};
+
+    auto error = Error::create("Disk full", SourceCodeLocation("store.cpp", 42, "flush"));
+    error.context("While saving the journal", SourceCodeLocation("journal.cpp", 7, "save"))
+        .context("While shutting down");
+    const auto written = serialize_into(error, Span<std::byte>(buffer));
+    ASSERT_TRUE(written.is_ok());
+    ASSERT_EQ(written.ok().value(), serialized_size(error));
+
+    const auto decoded = deserialize<Error>(Span<std::byte const>(buffer.data(), written.ok().value()));
+    ASSERT_TRUE(decoded.is_ok());
+    const auto view = decoded.ok().value();
+    ASSERT_EQ(view.view(), "Disk full");
+    ASSERT_EQ(view.code(), 0);
+    ASSERT_EQ(view.location()->file(), "store.cpp");
+    ASSERT_EQ(view.location()->line(), 42);
+    ASSERT_EQ(view.location()->function(), "flush");
+    ASSERT_EQ(view.context_count(), 2);
+    ASSERT_EQ(view.context_message(0), "While saving the journal");
+    ASSERT_EQ(view.context_message(1), "While shutting down");
+    ASSERT_EQ(view.context_location(0)->file(), "journal.cpp");
+    ASSERT_FALSE(view.context_location(1).has_value());
+    ASSERT_EQ(view.info(), error.info());
+    // Decoding copies nothing, the message is still in the buffer.
+    ASSERT_GE(view.view().data(), reinterpret_cast<char const *>(buffer.data()));
+    ASSERT_LT(view.view().data(), reinterpret_cast<char const *>(buffer.data() + buffer.size()));
+
+    const auto code = StaticError::create("Timed out", 110);
+    ASSERT_TRUE(serialize_into(code, Span<std::byte>(buffer)).is_ok());
+    const auto codeView = deserialize<StaticError>(Span<std::byte const>(buffer)).ok().value();
+    ASSERT_EQ(codeView.view(), "Timed out");
+    ASSERT_EQ(codeView.code(), 110);
+    ASSERT_FALSE(codeView.location().has_value());
+    ASSERT_EQ(codeView.info(), "Timed out");
+
+    using Reply = Result<uint64_t, StaticError>;
+    ASSERT_TRUE(serialize_into(Reply(uint64_t{7}), Span<std::byte>(buffer)).is_ok());
+    const auto okReply = deserialize<Reply>(Span<std::byte const>(buffer)).ok().value();
+    ASSERT_TRUE(okReply.is_ok());
+    ASSERT_EQ(okReply.ok().value(), 7);
+
+    ASSERT_TRUE(serialize_into(Reply(code), Span<std::byte>(buffer)).is_ok());
+    const auto errReply = deserialize<Reply>(Span<std::byte const>(buffer)).ok().value();
+    ASSERT_TRUE(errReply.is_err());
+    ASSERT_EQ(errReply.err()->code(), 110);
+}
+
+TEST(EtlResult, SerializeRejectsShortBuffers)
+{
+    const auto error = Error::create("Disk full", SourceCodeLocation("store.cpp", 42, "flush"));
+    const auto size = serialized_size(error);
+
+    std::vector<std::byte> buffer(size);
+    ASSERT_TRUE(serialize_into(error, Span<std::byte>(buffer.data(), size - 1)).is_err());
+    ASSERT_TRUE(serialize_into(error, Span<std::byte>(buffer)).is_ok());
+
+    for (std::size_t truncated = 0; truncated < size; ++truncated)
+    {
+        ASSERT_TRUE(deserialize<Error>(Span<std::byte const>(buffer.data(), truncated)).is_err());
+    }
+    // An error record is not a result record.
+    using Reply = Result<int, Error>;
+    ASSERT_TRUE(deserialize<Reply>(Span<std::byte const>(buffer)).is_err());
+
+    // Lengths are 32 bit, a longer string is refused rather than cut short. It is never read, only measured.
+    const char unread = 'x';
+    const auto huge = StaticError::create(
+        std::string_view(&unread, static_cast<std::size_t>(std::numeric_limits<uint32_t>::max()) + 1));
+    const auto tooLong = serialize_into(huge, Span<std::byte>(buffer));
+    ASSERT_TRUE(tooLong.is_err());
+    ASSERT_EQ(tooLong.err()->msg(), "String too long to serialize");
+}
+
+TEST(EtlResult, DeserializeRejectsContextCountsThatDoNotMatchTheFrames)
+{
+    const auto bare = Error::create("x");
+    auto framed = bare;
+    framed.context("while saving", SourceCodeLocation("store.cpp", 7, "save"));
+
+    // The frame count comes right after the message and location, followed by the size of the frames.
+    const auto countAt = serialized_size(bare) - sizeof(uint32_t) * 2;
+    const auto withCount = [countAt](Error const &error, uint32_t count) {
+        std::vector<std::byte> buffer(serialized_size(error));
+        EXPECT_TRUE(serialize_into(error, Span<std::byte>(buffer)).is_ok());
+        std::memcpy(buffer.data() + countAt, &count, sizeof(count));
+        return buffer;
+    };
+
+    const auto intact = withCount(framed, 1);
+    const auto decoded = deserialize<Error>(Span<std::byte const>(intact));
+    ASSERT_TRUE(decoded.is_ok());
+    ASSERT_EQ(decoded.ok().value().info(), framed.info());
+
+    // More frames than there are bytes for, fewer than there are, and frames where none were announced.
+    const auto tooMany = withCount(bare, 1'000'000);
+    ASSERT_TRUE(deserialize<Error>(Span<std::byte const>(tooMany)).is_err());
+    const auto oneShort = withCount(framed, 2);
+    ASSERT_TRUE(deserialize<Error>(Span<std::byte const>(oneShort)).is_err());
+    const auto unannounced = withCount(framed, 0);
+    ASSERT_TRUE(deserialize<Error>(Span<std::byte const>(unannounced)).is_err());
+}
+
+#if ETL_HAS_ERROR_SINK
+#include <unistd.h>
+
+namespace
+{
+auto readAll(int fd) -> std::string
+{
+    std::string text;
+    std::array<char, 4096> buffer{};
+    for (auto count = ::read(fd, buffer.data(), buffer.size()); count > 0;
+         count = ::read(fd, buffer.data(), buffer.size()))
+    {
+        text.append(buffer.data(), static_cast<std::size_t>(count));
+    }
+    return text;
+}
+
+auto countOf(std::string const &text, std::string_view const &needle) -> std::size_t
+{
+    std::size_t count = 0;
+    for (auto pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + needle.size()))
+    {
+        ++count;
+    }
+    return count;
+}
+
+auto failToSave() -> Error
+{
+    return Error::create("Disk full", RUNTIME_INFO).context("while saving", RUNTIME_INFO).context("on shutdown");
+}
+} // namespace
+
+TEST(EtlErrorSink, WritesEveryRecordFromEveryThread)
+{
+    constexpr std::size_t threads = 4;
+    constexpr std::size_t errors_per_thread = 50;
+
+    std::array<int, 2> fds{};
+    ASSERT_EQ(::pipe(fds.data()), 0);
+    {
+        // A tiny queue, so producers regularly find it full and have to wait for the writer.
+        ErrorSink sink(fds[1], 2, OverflowPolicy::Block);
+        std::vector<std::thread> workers;
+        for (std::size_t thread = 0; thread < threads; ++thread)
+        {
+            workers.emplace_back([&sink] {
+                for (std::size_t i = 0; i < errors_per_thread; ++i)
+                {
+                    ASSERT_TRUE(sink.push(failToSave()));
+                    ASSERT_TRUE(sink.push(StaticError::create("Queue is empty")));
+                }
+            });
+        }
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+        sink.flush();
+        sink.shutdown();
+        ASSERT_EQ(sink.dropped(), 0U);
+        ASSERT_FALSE(sink.push(StaticError::create("After shutdown")));
+    }
+    ::close(fds[1]);
+    const auto text = readAll(fds[0]);
+    ::close(fds[0]);
+
+    // Records are laid out exactly like info(), context locations included.
+    ASSERT_EQ(countOf(text, failToSave().info() + "\n"), threads * errors_per_thread);
+    ASSERT_EQ(countOf(text, "Queue is empty\n"), threads * errors_per_thread);
+    ASSERT_EQ(countOf(text, "After shutdown"), 0U);
+}
+
+TEST(EtlErrorSink, ShutdownWritesEveryAcceptedRecord)
+{
+    constexpr std::size_t threads = 8;
+    constexpr std::size_t max_per_thread = 200;
+
+    std::array<int, 2> fds{};
+    ASSERT_EQ(::pipe(fds.data()), 0);
+    std::atomic<std::size_t> accepted{0};
+    {
+        // More producers than slots, all of them blocked on a full queue while the sink shuts down.
+        ErrorSink sink(fds[1], 2, OverflowPolicy::Block);
+        std::atomic<std::size_t> started{0};
+        std::vector<std::thread> workers;
+        for (std::size_t thread = 0; thread < threads; ++thread)
+        {
+            workers.emplace_back([&] {
+                started.fetch_add(1);
+                for (std::size_t i = 0; i < max_per_thread && sink.push(StaticError::create("Accepted")); ++i)
+                {
+                    accepted.fetch_add(1);
+                }
+            });
+        }
+        while (started.load() < threads)
+        {
+            std::this_thread::yield();
+        }
+        sink.shutdown();
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+    }
+    ::close(fds[1]);
+    const auto text = readAll(fds[0]);
+    ::close(fds[0]);
+
+    // Every push() that returned true was written, none of them after the writer thread stopped.
+    ASSERT_EQ(countOf(text, "Accepted\n"), accepted.load());
+}
+#endif
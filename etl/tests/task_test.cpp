@@ -0,0 +1,228 @@
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <etl.hpp>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace etl;
+
+namespace
+{
+
+auto square(int32_t value) -> Result<int32_t, Error>
+{
+    if (value < 0)
+    {
+        return Result<int32_t, Error>(Error::create("Negative input " + std::to_string(value)));
+    }
+    return Result<int32_t, Error>(value * value);
+}
+
+/// @brief Splits the range in two until it is small, every split spawns and waits from inside the pool.
+auto sumOfSquares(ThreadPool &pool, int32_t first, int32_t last) -> int64_t
+{
+    if (last - first <= 8)
+    {
+        int64_t sum = 0;
+        for (auto value = first; value < last; ++value)
+        {
+            sum += square(value).ok().value();
+        }
+        return sum;
+    }
+    const auto middle = first + (last - first) / 2;
+    auto left = pool.spawn([&pool, first, middle] { return sumOfSquares(pool, first, middle); });
+    const auto right = sumOfSquares(pool, middle, last);
+    return left.get() + right;
+}
+
+} // namespace
+
+TEST(EtlTask, SpawnedTasksCompleteWithTheirResult)
+{
+    ThreadPool pool(4);
+    ASSERT_EQ(pool.size(), 4);
+
+    auto ok = pool.spawn([] { return square(7); });
+    auto err = pool.spawn([] { return square(-1); });
+    ASSERT_EQ(ok.get().ok().value(), 49);
+    ASSERT_EQ(err.get().err()->msg(), "Negative input -1");
+    ASSERT_TRUE(ok.is_ready());
+
+    auto doubled = ok.then([](Result<int32_t, Error> const &result) { return result.ok().value() * 2; });
+    ASSERT_EQ(doubled.get(), 98);
+}
+
+TEST(EtlTask, WhenAllKeepsTheOrderOfItsTasks)
+{
+    ThreadPool pool(4);
+    std::vector<Task<Result<int32_t, Error>>> tasks;
+    for (int32_t value = -2; value < 62; ++value)
+    {
+        tasks.push_back(pool.spawn([value] { return square(value); }));
+    }
+
+    const auto results = when_all(std::move(tasks)).get();
+    ASSERT_EQ(results.size(), 64);
+    ASSERT_TRUE(results[0].is_err());
+    ASSERT_TRUE(results[1].is_err());
+    for (std::size_t index = 2; index < results.size(); ++index)
+    {
+        const auto value = static_cast<int32_t>(index) - 2;
+        ASSERT_EQ(results[index].ok().value(), value * value);
+    }
+
+    ASSERT_TRUE(when_all(std::vector<Task<int32_t>>()).get().empty());
+}
+
+TEST(EtlTask, WhenAnyCompletesWithTheFirstTask)
+{
+    ThreadPool pool(2);
+    std::atomic<bool> release{false};
+    std::vector<Task<int32_t>> tasks;
+    tasks.push_back(pool.spawn([&release] {
+        while (!release.load())
+        {
+            std::this_thread::yield();
+        }
+        return 1;
+    }));
+    tasks.push_back(pool.spawn([] { return 2; }));
+
+    const auto first = when_any(tasks).get();
+    ASSERT_EQ(first.index, 1);
+    ASSERT_EQ(first.value, 2);
+    release.store(true);
+    ASSERT_EQ(tasks[0].get(), 1);
+}
+
+TEST(EtlTask, ExceptionsAreStoredInTheTask)
+{
+    ThreadPool pool(2);
+    auto failed = pool.spawn([]() -> int32_t { throw std::runtime_error("worker failed"); });
+    EXPECT_THROW(static_cast<void>(failed.get()), std::runtime_error);
+
+    // then() passes the exception on without running, and catches what its own function throws.
+    std::atomic<bool> ran{false};
+    auto skipped = failed.then([&ran](int32_t value) {
+        ran.store(true);
+        return value;
+    });
+    EXPECT_THROW(static_cast<void>(skipped.get()), std::runtime_error);
+    ASSERT_FALSE(ran.load());
+    auto throwing = pool.spawn([] { return 1; }).then([](int32_t) -> int32_t { throw std::logic_error("then"); });
+    EXPECT_THROW(static_cast<void>(throwing.get()), std::logic_error);
+
+    std::vector<Task<int32_t>> tasks{pool.spawn([] { return 1; }), failed};
+    EXPECT_THROW(static_cast<void>(when_all(tasks).get()), std::runtime_error);
+    EXPECT_THROW(static_cast<void>(when_any(std::vector<Task<int32_t>>{failed}).get()), std::runtime_error);
+
+    // The pool survives, its workers keep running jobs.
+    ASSERT_EQ(pool.spawn([] { return 3; }).get(), 3);
+}
+
+TEST(EtlTask, WorkersWaitingOnTasksKeepRunningJobs)
+{
+    // A single worker has to run the tasks it waits on itself.
+    for (const std::size_t threads : {std::size_t{1}, std::size_t{4}})
+    {
+        ThreadPool pool(threads);
+        auto sum = pool.spawn([&pool] { return sumOfSquares(pool, 0, 10'000); });
+        int64_t expected = 0;
+        for (int64_t value = 0; value < 10'000; ++value)
+        {
+            expected += value * value;
+        }
+        ASSERT_EQ(sum.get(), expected);
+    }
+}
+
+TEST(EtlTask, DestroyingThePoolRunsQueuedJobs)
+{
+    std::atomic<std::size_t> ran{0};
+    {
+        ThreadPool pool(2);
+        for (std::size_t i = 0; i < 10'000; ++i)
+        {
+            pool.post([&ran] { ran.fetch_add(1, std::memory_order_relaxed); });
+        }
+    }
+    ASSERT_EQ(ran.load(), 10'000);
+}
+
+TEST(EtlTask, TransformResultsWritesValuesAndReportsErrorsPerChunk)
+{
+    ThreadPool pool(4);
+    std::vector<int32_t> input(100'000);
+    for (std::size_t index = 0; index < input.size(); ++index)
+    {
+        // Every 1000th record is invalid.
+        input[index] = index % 1000 == 999 ? -1 : static_cast<int32_t>(index % 1000);
+    }
+    std::vector<int32_t> output(input.size(), 0);
+
+    const auto report = transform_results(pool, Span<int32_t const>(input), Span<int32_t>(output), square, 10'000);
+    ASSERT_FALSE(report.ok());
+    ASSERT_EQ(report.chunk_size, 10'000);
+    ASSERT_EQ(report.chunk_errors, std::vector<std::size_t>(10, 10));
+    ASSERT_EQ(report.error_count(), 100);
+    for (std::size_t error = 0; error < report.errors.size(); ++error)
+    {
+        ASSERT_EQ(report.errors[error].index, error * 1000 + 999);
+        ASSERT_EQ(report.errors[error].error.msg(), "Negative input -1");
+    }
+    for (std::size_t index = 0; index < output.size(); ++index)
+    {
+        ASSERT_EQ(output[index], index % 1000 == 999 ? 0 : input[index] * input[index]);
+    }
+
+    const auto none = transform_results(pool, Span<int32_t const>(), Span<int32_t>(), square);
+    ASSERT_TRUE(none.ok());
+    ASSERT_TRUE(none.chunk_errors.empty());
+}
+
+TEST(EtlTask, TransformResultsPicksChunksOfWholeCacheLines)
+{
+    class Triple
+    {
+      public:
+        std::array<int32_t, 3> values{};
+    };
+    ThreadPool pool(2);
+    std::vector<int32_t> input(50'000, 1);
+    std::vector<Triple> output(input.size());
+
+    const auto report =
+        transform_results(pool, Span<int32_t const>(input), Span<Triple>(output),
+                          [](int32_t value) { return Result<Triple, Error>(Triple{{value, value, value}}); });
+    ASSERT_TRUE(report.ok());
+    ASSERT_EQ(report.chunk_size * sizeof(Triple) % internal::cache_line_size, 0);
+    ASSERT_EQ(output.back().values[2], 1);
+}
+
+TEST(EtlTask, TransformResultsRethrowsTheFirstException)
+{
+    ThreadPool pool(4);
+    std::vector<int32_t> input(100'000, 1);
+    input[12'345] = 0;
+    std::vector<int32_t> output(input.size(), 0);
+
+    const auto throwOnZero = [](int32_t value) {
+        if (value == 0)
+        {
+            throw std::runtime_error("zero");
+        }
+        return square(value);
+    };
+    EXPECT_THROW(static_cast<void>(transform_results(pool, Span<int32_t const>(input), Span<int32_t>(output),
+                                                     throwOnZero, 1'000)),
+                 std::runtime_error);
+
+    // Every chunk has finished by the time the exception arrives, and the pool keeps running jobs.
+    ASSERT_EQ(pool.spawn([] { return 3; }).get(), 3);
+}